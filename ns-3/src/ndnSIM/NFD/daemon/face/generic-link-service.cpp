@@ -25,6 +25,7 @@
 
 #include "generic-link-service.hpp"
 #include <ndn-cxx/lp/tags.hpp>
+#include <cmath>
 
 namespace nfd {
 namespace face {
@@ -40,6 +41,12 @@ GenericLinkService::Options::Options()
   : allowLocalFields(false)
   , allowFragmentation(false)
   , allowReassembly(false)
+  , allowCongestionMarking(false)
+  , baseCongestionMarkingInterval(time::milliseconds(100)) // Interval from CoDel
+  , defaultCongestionThreshold(65536) // 2^16 bytes
+  , allowBundling(false)
+  , bundleMaxDelay(time::milliseconds(1))
+  , bundleMaxSize(1400)
 {
 }
 
@@ -49,6 +56,9 @@ GenericLinkService::GenericLinkService(const GenericLinkService::Options& option
   , m_fragmenter(m_options.fragmenterOptions, this)
   , m_reassembler(m_options.reassemblerOptions, this)
   , m_lastSeqNo(-2)
+  , m_nextMarkTime(time::steady_clock::TimePoint::max())
+  , m_nMarkedSinceInMarkingState(0)
+  , m_bundleSize(0)
 {
   m_reassembler.beforeTimeout.connect(bind([this] { ++this->nReassemblyTimeouts; }));
 }
@@ -143,6 +153,10 @@ GenericLinkService::encodeLpFields(const ndn::TagHost& netPkt, lp::Packet& lpPac
 void
 GenericLinkService::sendNetPacket(lp::Packet&& pkt)
 {
+  if (m_options.allowCongestionMarking) {
+    this->checkCongestionLevel(pkt);
+  }
+
   std::vector<lp::Packet> frags;
   const ssize_t mtu = this->getTransport()->getMtu();
   if (m_options.allowFragmentation && mtu != MTU_UNLIMITED) {
@@ -177,7 +191,110 @@ GenericLinkService::sendNetPacket(lp::Packet&& pkt)
       NFD_LOG_FACE_WARN("attempt to send packet over MTU limit");
       continue;
     }
+    this->sendLpPacket(std::move(tp));
+  }
+}
+
+/** \return size of a bundle frame whose elements take \p bundleSize bytes
+ */
+static size_t
+getBundleFrameSize(size_t bundleSize)
+{
+  return tlv::sizeOfVarNumber(lp::tlv::LpBundle) + tlv::sizeOfVarNumber(bundleSize) + bundleSize;
+}
+
+void
+GenericLinkService::sendLpPacket(Transport::Packet&& tp)
+{
+  if (!m_options.allowBundling) {
     this->sendPacket(std::move(tp));
+    return;
+  }
+
+  size_t maxSize = m_options.bundleMaxSize;
+  const ssize_t mtu = this->getTransport()->getMtu();
+  if (mtu > 0) {
+    maxSize = std::min(maxSize, static_cast<size_t>(mtu));
+  }
+
+  size_t packetSize = tp.packet.size();
+  if (getBundleFrameSize(m_bundleSize + packetSize) > maxSize) {
+    this->flushBundle();
+    if (getBundleFrameSize(packetSize) > maxSize) {
+      // too large to be bundled with anything
+      this->sendPacket(std::move(tp));
+      return;
+    }
+  }
+
+  m_bundle.push_back(std::move(tp.packet));
+  m_bundleSize += packetSize;
+  if (m_bundle.size() == 1) {
+    m_bundleFlushEvent = scheduler::schedule(m_options.bundleMaxDelay,
+                                             bind(&GenericLinkService::flushBundle, this));
+  }
+}
+
+void
+GenericLinkService::flushBundle()
+{
+  m_bundleFlushEvent.cancel();
+  if (m_bundle.empty()) {
+    return;
+  }
+
+  std::vector<Block> bundle;
+  bundle.swap(m_bundle);
+  m_bundleSize = 0;
+
+  if (bundle.size() == 1) {
+    this->sendPacket(Transport::Packet(std::move(bundle.front())));
+    return;
+  }
+
+  Block frame(lp::tlv::LpBundle);
+  for (const Block& pkt : bundle) {
+    frame.push_back(pkt);
+    ++this->nOutBundled;
+  }
+  frame.encode();
+  NFD_LOG_FACE_TRACE("sending bundle of " << bundle.size() << " LpPackets");
+  this->sendPacket(Transport::Packet(std::move(frame)));
+}
+
+void
+GenericLinkService::checkCongestionLevel(lp::Packet& pkt)
+{
+  ssize_t sendQueueLength = this->getTransport()->getSendQueueLength();
+  // this operation requires that the transport supports retrieving current send queue length
+  if (sendQueueLength < 0) {
+    return;
+  }
+
+  if (static_cast<size_t>(sendQueueLength) > m_options.defaultCongestionThreshold) {
+    time::steady_clock::TimePoint now = time::steady_clock::now();
+    if (m_nextMarkTime == time::steady_clock::TimePoint::max()) {
+      // congestion incident has started, mark only if it lasts at least one interval
+      m_nextMarkTime = now + m_options.baseCongestionMarkingInterval;
+      NFD_LOG_FACE_DEBUG("txqlen=" << sendQueueLength << " exceeded congestion threshold");
+    }
+    else if (now >= m_nextMarkTime) {
+      pkt.set<lp::CongestionMarkField>(1);
+      ++this->nCongestionMarked;
+      ++m_nMarkedSinceInMarkingState;
+      NFD_LOG_FACE_DEBUG("txqlen=" << sendQueueLength << " LpPacket marked as congested");
+
+      // shorten the interval by the inverse square root of the marks in this incident
+      m_nextMarkTime += time::nanoseconds(static_cast<time::nanoseconds::rep>(
+                          m_options.baseCongestionMarkingInterval.count() /
+                          std::sqrt(m_nMarkedSinceInMarkingState + 1)));
+    }
+  }
+  else if (m_nextMarkTime != time::steady_clock::TimePoint::max()) {
+    // congestion incident has ended
+    NFD_LOG_FACE_DEBUG("txqlen=" << sendQueueLength << " dropped below congestion threshold");
+    m_nextMarkTime = time::steady_clock::TimePoint::max();
+    m_nMarkedSinceInMarkingState = 0;
   }
 }
 
@@ -195,9 +312,32 @@ GenericLinkService::assignSequences(std::vector<lp::Packet>& pkts)
 
 void
 GenericLinkService::doReceivePacket(Transport::Packet&& packet)
+{
+  if (packet.packet.type() != lp::tlv::LpBundle) {
+    this->receiveLpPacket(packet.packet, packet.remoteEndpoint);
+    return;
+  }
+
+  try {
+    packet.packet.parse();
+  }
+  catch (const tlv::Error& e) {
+    ++this->nInLpInvalid;
+    NFD_LOG_FACE_WARN("bundle parse error (" << e.what() << "): DROP");
+    return;
+  }
+
+  for (const Block& element : packet.packet.elements()) {
+    ++this->nInBundled;
+    this->receiveLpPacket(element, packet.remoteEndpoint);
+  }
+}
+
+void
+GenericLinkService::receiveLpPacket(const Block& packet, Transport::EndpointId remoteEndpoint)
 {
   try {
-    lp::Packet pkt(packet.packet);
+    lp::Packet pkt(packet);
 
     if (!pkt.has<lp::FragmentField>()) {
       NFD_LOG_FACE_TRACE("received IDLE packet: DROP");
@@ -213,8 +353,7 @@ GenericLinkService::doReceivePacket(Transport::Packet&& packet)
     bool isReassembled = false;
     Block netPkt;
     lp::Packet firstPkt;
-    std::tie(isReassembled, netPkt, firstPkt) = m_reassembler.receiveFragment(packet.remoteEndpoint,
-                                                                              pkt);
+    std::tie(isReassembled, netPkt, firstPkt) = m_reassembler.receiveFragment(remoteEndpoint, pkt);
     if (isReassembled) {
       this->decodeNetPacket(netPkt, firstPkt);
     }
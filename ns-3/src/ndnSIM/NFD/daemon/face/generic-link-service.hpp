@@ -28,6 +28,7 @@
 
 #include "core/common.hpp"
 #include "core/logger.hpp"
+#include "core/scheduler.hpp"
 
 #include "link-service.hpp"
 #include "lp-fragmenter.hpp"
@@ -71,6 +72,18 @@ public:
   /** \brief count of invalid reassembled network-layer packets dropped
    */
   PacketCounter nInNetInvalid;
+
+  /** \brief count of outgoing LpPackets that were marked with congestion marks
+   */
+  PacketCounter nCongestionMarked;
+
+  /** \brief count of outgoing LpPackets that were sent inside a bundle
+   */
+  PacketCounter nOutBundled;
+
+  /** \brief count of incoming LpPackets that were received inside a bundle
+   */
+  PacketCounter nInBundled;
 };
 
 /** \brief GenericLinkService is a LinkService that implements the NDNLPv2 protocol
@@ -107,6 +120,38 @@ public:
     /** \brief options for reassembly
      */
     LpReassembler::Options reassemblerOptions;
+
+    /** \brief enables send queue congestion detection and marking
+     */
+    bool allowCongestionMarking;
+
+    /** \brief starting value for congestion marking interval
+     *
+     *  The send queue must stay above the congestion threshold for this long
+     *  before the first packet is marked.
+     */
+    time::nanoseconds baseCongestionMarkingInterval;
+
+    /** \brief default congestion threshold in bytes
+     */
+    size_t defaultCongestionThreshold;
+
+    /** \brief enables bundling of outgoing LpPackets into one link frame
+     *
+     *  Bundles are always unbundled on receipt, whether or not this is enabled.
+     */
+    bool allowBundling;
+
+    /** \brief longest time an LpPacket waits for others to be bundled with
+     */
+    time::nanoseconds bundleMaxDelay;
+
+    /** \brief maximum size of a bundle frame in bytes
+     *
+     *  The MTU of the transport, if smaller, takes precedence.
+     *  An LpPacket that does not fit alone is sent unbundled.
+     */
+    size_t bundleMaxSize;
   };
 
   /** \brief counters provided by GenericLinkService
@@ -158,6 +203,29 @@ private: // send path
   void
   sendNetPacket(lp::Packet&& pkt);
 
+  /** \brief mark an LpPacket as congested if the send queue has stayed congested
+   *
+   *  Marking follows CoDel: once the send queue length has stayed above the congestion
+   *  threshold for one marking interval, the packet is marked, and while the queue stays
+   *  above the threshold, the n-th following mark is sent one interval / sqrt(n + 1) later.
+   *  The marking state is reset as soon as the queue drops below the threshold.
+   */
+  void
+  checkCongestionLevel(lp::Packet& pkt);
+
+  /** \brief send an encoded LpPacket, bundled with others if bundling is enabled
+   *
+   *  A packet is appended to the pending bundle, which is sent when the next packet would
+   *  not fit in bundleMaxSize, or bundleMaxDelay after its first packet was appended.
+   */
+  void
+  sendLpPacket(Transport::Packet&& tp);
+
+  /** \brief send the pending bundle; a bundle of one packet is sent as a plain LpPacket
+   */
+  void
+  flushBundle();
+
   /** \brief assign a sequence number to an LpPacket
    */
   void
@@ -174,6 +242,11 @@ private: // receive path
   void
   doReceivePacket(Transport::Packet&& packet) override;
 
+  /** \brief process a received LpPacket, either received alone or extracted from a bundle
+   */
+  void
+  receiveLpPacket(const Block& packet, Transport::EndpointId remoteEndpoint);
+
   /** \brief decode incoming network-layer packet
    *  \param netPkt reassembled network-layer packet
    *  \param firstPkt LpPacket of first fragment
@@ -225,6 +298,19 @@ private:
   LpFragmenter m_fragmenter;
   LpReassembler m_reassembler;
   lp::Sequence m_lastSeqNo;
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /// Time to mark next packet due to send queue congestion, max() if not congested
+  time::steady_clock::TimePoint m_nextMarkTime;
+  /// number of marked packets in the current incident of congestion
+  size_t m_nMarkedSinceInMarkingState;
+
+  /// LpPackets waiting to be sent in one bundle
+  std::vector<Block> m_bundle;
+  /// total size of m_bundle elements
+  size_t m_bundleSize;
+  /// sends the pending bundle when its delay budget runs out
+  scheduler::ScopedEventId m_bundleFlushEvent;
 };
 
 inline const GenericLinkService::Options&
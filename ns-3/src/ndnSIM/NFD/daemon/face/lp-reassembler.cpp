@@ -25,7 +25,7 @@
 
 #include "lp-reassembler.hpp"
 #include "link-service.hpp"
-#include <numeric>
+#include <limits>
 
 namespace nfd {
 namespace face {
@@ -35,15 +35,57 @@ NFD_LOG_INIT("LpReassembler");
 LpReassembler::Options::Options()
   : nMaxFragments(400)
   , reassemblyTimeout(time::milliseconds(500))
+  , nMaxPartialPackets(64)
 {
 }
 
+static const size_t NOT_RECEIVED = std::numeric_limits<size_t>::max();
+
+LpReassembler::PartialPacket::PartialPacket()
+  : remoteEndpoint(0)
+  , messageIdentifier(0)
+  , fragCount(0)
+  , nReceivedFragments(0)
+  , isInOrder(true)
+{
+}
+
+/** \return smallest power of 2 that keeps the table at most half full
+ */
+static size_t
+computeTableSize(size_t nMaxPartialPackets)
+{
+  size_t tableSize = 2;
+  while (tableSize < 2 * nMaxPartialPackets) {
+    tableSize <<= 1;
+  }
+  return tableSize;
+}
+
 LpReassembler::LpReassembler(const LpReassembler::Options& options, const LinkService* linkService)
   : m_options(options)
+  , m_table(computeTableSize(options.nMaxPartialPackets))
+  , m_nPartialPackets(0)
+  , m_isSweepScheduled(false)
   , m_linkService(linkService)
 {
 }
 
+void
+LpReassembler::setOptions(const Options& options)
+{
+  bool needResize = options.nMaxPartialPackets != m_options.nMaxPartialPackets;
+  m_options = options;
+
+  if (needResize) {
+    m_table.clear();
+    m_table.resize(computeTableSize(m_options.nMaxPartialPackets));
+    m_nPartialPackets = 0;
+    m_sweepEvent.cancel();
+    m_isSweepScheduled = false;
+  }
+}
+
 std::tuple<bool, Block, lp::Packet>
 LpReassembler::receiveFragment(Transport::EndpointId remoteEndpoint, const lp::Packet& packet)
 {
@@ -85,79 +127,180 @@ LpReassembler::receiveFragment(Transport::EndpointId remoteEndpoint, const lp::P
     return FALSE_RETURN;
   }
   lp::Sequence messageIdentifier = packet.get<lp::SequenceField>() - fragIndex;
-  Key key = std::make_tuple(remoteEndpoint, messageIdentifier);
 
-  // add to PartialPacket
-  PartialPacket& pp = m_partialPackets[key];
-  if (pp.fragCount == 0) { // new PartialPacket
+  // find or add PartialPacket
+  size_t index = this->findSlot(remoteEndpoint, messageIdentifier);
+  if (!m_table[index].isInUse()) { // new PartialPacket
+    if (m_nPartialPackets >= m_options.nMaxPartialPackets) {
+      // make room from partial packets that have timed out but are not swept yet
+      this->sweep();
+      if (m_nPartialPackets >= m_options.nMaxPartialPackets) {
+        NFD_LOG_FACE_WARN("reassembly error, too many partial packets: DROP");
+        return FALSE_RETURN;
+      }
+      index = this->findSlot(remoteEndpoint, messageIdentifier);
+    }
+
+    PartialPacket& pp = m_table[index];
+    pp.remoteEndpoint = remoteEndpoint;
+    pp.messageIdentifier = messageIdentifier;
     pp.fragCount = fragCount;
     pp.nReceivedFragments = 0;
-    pp.fragments.resize(fragCount);
+    pp.isInOrder = true;
+    pp.fragments.assign(fragCount, std::make_pair(NOT_RECEIVED, 0));
+    if (pp.payload == nullptr) {
+      pp.payload = make_shared<ndn::Buffer>();
+    }
+    pp.payload->clear();
+    ++m_nPartialPackets;
   }
   else {
-    if (fragCount != pp.fragCount) {
+    if (fragCount != m_table[index].fragCount) {
       NFD_LOG_FACE_WARN("reassembly error, FragCount changed: DROP");
       return FALSE_RETURN;
     }
   }
+  PartialPacket& pp = m_table[index];
 
-  if (pp.fragments[fragIndex].has<lp::SequenceField>()) {
+  if (pp.fragments[fragIndex].first != NOT_RECEIVED) {
     NFD_LOG_FACE_TRACE("fragment already received: DROP");
     return FALSE_RETURN;
   }
 
-  pp.fragments[fragIndex] = packet;
+  ndn::Buffer::const_iterator fragBegin, fragEnd;
+  std::tie(fragBegin, fragEnd) = packet.get<lp::FragmentField>();
+  size_t fragSize = std::distance(fragBegin, fragEnd);
+  if (pp.nReceivedFragments == 0) {
+    // fragments other than the last are usually of the same size
+    pp.payload->reserve(fragSize * pp.fragCount);
+  }
+  pp.fragments[fragIndex] = std::make_pair(pp.payload->size(), fragSize);
+  pp.payload->insert(pp.payload->end(), fragBegin, fragEnd);
+  pp.isInOrder = pp.isInOrder && fragIndex == pp.nReceivedFragments;
   ++pp.nReceivedFragments;
+  if (fragIndex == 0) {
+    pp.firstFragment = packet;
+  }
 
   // check complete condition
   if (pp.nReceivedFragments == pp.fragCount) {
-    Block reassembled = doReassembly(key);
-    lp::Packet firstFrag(std::move(pp.fragments[0]));
-    m_partialPackets.erase(key);
+    Block reassembled = doReassembly(pp);
+    lp::Packet firstFrag(std::move(pp.firstFragment));
+    this->eraseSlot(index);
     return std::make_tuple(true, reassembled, firstFrag);
   }
 
-  // set drop timer
-  pp.dropTimer = scheduler::schedule(m_options.reassemblyTimeout,
-                                     bind(&LpReassembler::timeoutPartialPacket, this, key));
+  // (re)start timeout
+  pp.expiry = time::steady_clock::now() + m_options.reassemblyTimeout;
+  if (!m_isSweepScheduled) {
+    this->scheduleSweep(pp.expiry);
+  }
 
   return FALSE_RETURN;
 }
 
-Block
-LpReassembler::doReassembly(const Key& key)
+size_t
+LpReassembler::getHomeSlot(Transport::EndpointId remoteEndpoint, lp::Sequence messageIdentifier) const
 {
-  PartialPacket& pp = m_partialPackets[key];
+  uint64_t h = (messageIdentifier + remoteEndpoint * 0x9e3779b97f4a7c15ULL) * 0xbf58476d1ce4e5b9ULL;
+  h ^= h >> 31;
+  return static_cast<size_t>(h) & (m_table.size() - 1);
+}
 
-  size_t payloadSize = std::accumulate(pp.fragments.begin(), pp.fragments.end(), 0,
-    [&] (size_t sum, const lp::Packet& pkt) -> size_t {
-      ndn::Buffer::const_iterator fragBegin, fragEnd;
-      std::tie(fragBegin, fragEnd) = pkt.get<lp::FragmentField>();
-      return sum + std::distance(fragBegin, fragEnd);
-    });
+size_t
+LpReassembler::findSlot(Transport::EndpointId remoteEndpoint, lp::Sequence messageIdentifier) const
+{
+  // the table is at most half full, so a free slot is always found
+  size_t mask = m_table.size() - 1;
+  size_t index = this->getHomeSlot(remoteEndpoint, messageIdentifier);
+  while (m_table[index].isInUse() &&
+         (m_table[index].remoteEndpoint != remoteEndpoint ||
+          m_table[index].messageIdentifier != messageIdentifier)) {
+    index = (index + 1) & mask;
+  }
+  return index;
+}
 
-  ndn::Buffer fragBuffer(payloadSize);
-  ndn::Buffer::iterator it = fragBuffer.begin();
+Block
+LpReassembler::doReassembly(PartialPacket& pp)
+{
+  if (pp.isInOrder) {
+    // the buffer already holds the packet: hand it over, a new one is allocated for the slot
+    shared_ptr<ndn::Buffer> payload;
+    payload.swap(pp.payload);
+    return Block(payload);
+  }
 
-  for (const lp::Packet& frag : pp.fragments) {
-    ndn::Buffer::const_iterator fragBegin, fragEnd;
-    std::tie(fragBegin, fragEnd) = frag.get<lp::FragmentField>();
-    it = std::copy(fragBegin, fragEnd, it);
+  shared_ptr<ndn::Buffer> payload = make_shared<ndn::Buffer>(pp.payload->size());
+  ndn::Buffer::iterator it = payload->begin();
+  for (const auto& frag : pp.fragments) {
+    ndn::Buffer::const_iterator fragBegin = pp.payload->begin() + frag.first;
+    it = std::copy(fragBegin, fragBegin + frag.second, it);
+  }
+  return Block(payload);
+}
+
+void
+LpReassembler::eraseSlot(size_t index)
+{
+  // backward shift deletion: move each following entry of the cluster into the hole,
+  // unless its home slot lies between the hole and the entry
+  size_t mask = m_table.size() - 1;
+  size_t hole = index;
+  for (size_t i = (index + 1) & mask; m_table[i].isInUse(); i = (i + 1) & mask) {
+    size_t home = this->getHomeSlot(m_table[i].remoteEndpoint, m_table[i].messageIdentifier);
+    if (((i - home) & mask) >= ((i - hole) & mask)) {
+      std::swap(m_table[hole], m_table[i]);
+      hole = i;
+    }
   }
 
-  return Block(&*(fragBuffer.cbegin()), std::distance(fragBuffer.cbegin(), fragBuffer.cend()));
+  // the fragments vector and payload buffer are kept for reuse
+  PartialPacket& pp = m_table[hole];
+  pp.fragCount = 0;
+  pp.firstFragment = lp::Packet();
+  --m_nPartialPackets;
 }
 
 void
-LpReassembler::timeoutPartialPacket(const Key& key)
+LpReassembler::sweep()
 {
-  auto it = m_partialPackets.find(key);
-  if (it == m_partialPackets.end()) {
-    return;
+  m_isSweepScheduled = false;
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  time::steady_clock::TimePoint nextExpiry = time::steady_clock::TimePoint::max();
+
+  for (size_t i = 0; i < m_table.size(); ++i) {
+    PartialPacket& pp = m_table[i];
+    if (!pp.isInUse()) {
+      continue;
+    }
+    if (pp.expiry > now) {
+      nextExpiry = std::min(nextExpiry, pp.expiry);
+      continue;
+    }
+
+    this->beforeTimeout(pp.remoteEndpoint, pp.nReceivedFragments);
+    this->eraseSlot(i);
+    // a following entry may have been moved into this slot
+    --i;
   }
 
-  this->beforeTimeout(std::get<0>(key), it->second.nReceivedFragments);
-  m_partialPackets.erase(it);
+  if (m_nPartialPackets > 0) {
+    this->scheduleSweep(nextExpiry);
+  }
+  else {
+    m_sweepEvent.cancel();
+  }
+}
+
+void
+LpReassembler::scheduleSweep(const time::steady_clock::TimePoint& when)
+{
+  time::nanoseconds delay = std::max(time::nanoseconds::zero(),
+                                     time::duration_cast<time::nanoseconds>(
+                                       when - time::steady_clock::now()));
+  m_sweepEvent = scheduler::schedule(delay, bind(&LpReassembler::sweep, this));
+  m_isSweepScheduled = true;
 }
 
 std::ostream&
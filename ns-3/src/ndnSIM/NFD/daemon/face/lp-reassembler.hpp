@@ -60,12 +60,21 @@ public:
     /** \brief timeout before a partially reassembled packet is dropped
      */
     time::nanoseconds reassemblyTimeout;
+
+    /** \brief maximum number of partial packets being reassembled at the same time
+     *
+     *  The first fragment of another packet is dropped while this many packets
+     *  are being reassembled and none of them has timed out.
+     */
+    size_t nMaxPartialPackets;
   };
 
   explicit
   LpReassembler(const Options& options = Options(), const LinkService* linkService = nullptr);
 
   /** \brief set options for reassembler
+   *
+   *  Partial packets are dropped if nMaxPartialPackets is changed.
    */
   void
   setOptions(const Options& options);
@@ -104,44 +113,75 @@ public:
   signal::Signal<LpReassembler, Transport::EndpointId, size_t> beforeTimeout;
 
 private:
-  /** \brief holds all fragments of packet until reassembled
+  /** \brief a slot of the reassembly table, holding the fragments of a packet until reassembled
+   *
+   *  Fragment payloads are appended to one buffer in arrival order. When the fragments
+   *  arrived in order, which is the common case, this buffer is the reassembled packet.
+   *  The fragments vector and, when not handed over, the buffer are reused by the next
+   *  packet occupying the slot.
    */
   struct PartialPacket
   {
-    std::vector<lp::Packet> fragments;
-    size_t fragCount; ///< total fragments
+    PartialPacket();
+
+    bool
+    isInUse() const
+    {
+      return fragCount > 0;
+    }
+
+    Transport::EndpointId remoteEndpoint;
+    lp::Sequence messageIdentifier; ///< sequence of the first fragment
+    size_t fragCount; ///< total fragments, 0 if the slot is free
     size_t nReceivedFragments; ///< number of received fragments
-    scheduler::ScopedEventId dropTimer;
+    bool isInOrder; ///< whether fragments have been received in FragIndex order
+    time::steady_clock::TimePoint expiry;
+    lp::Packet firstFragment;
+    shared_ptr<ndn::Buffer> payload;
+    /// offset and length in payload of each fragment, indexed by FragIndex
+    std::vector<std::pair<size_t, size_t>> fragments;
   };
 
-  /** \brief index key for PartialPackets
+  /** \return slot of the partial packet, or the free slot where it would be inserted
    */
-  typedef std::tuple<
-    Transport::EndpointId, // remoteEndpoint
-    lp::Sequence // message identifier (sequence of the first fragment)
-  > Key;
+  size_t
+  findSlot(Transport::EndpointId remoteEndpoint, lp::Sequence messageIdentifier) const;
+
+  size_t
+  getHomeSlot(Transport::EndpointId remoteEndpoint, lp::Sequence messageIdentifier) const;
 
   Block
-  doReassembly(const Key& key);
+  doReassembly(PartialPacket& pp);
 
+  /** \brief free slot \p index, moving following entries back to keep probe sequences intact
+   */
+  void
+  eraseSlot(size_t index);
+
+  /** \brief drop partial packets whose timeout has expired, then schedule the next sweep
+   *
+   *  One sweep event at a time is scheduled, at the earliest expiry known when scheduling;
+   *  fragments received later only update the expiry of their partial packet.
+   */
   void
-  timeoutPartialPacket(const Key& key);
+  sweep();
+
+  void
+  scheduleSweep(const time::steady_clock::TimePoint& when);
 
 private:
   Options m_options;
-  std::map<Key, PartialPacket> m_partialPackets;
+  /// open addressing table with linear probing; its size is a power of 2
+  std::vector<PartialPacket> m_table;
+  size_t m_nPartialPackets;
+  bool m_isSweepScheduled;
+  scheduler::ScopedEventId m_sweepEvent;
   const LinkService* m_linkService;
 };
 
 std::ostream&
 operator<<(std::ostream& os, const FaceLogHelper<LpReassembler>& flh);
 
-inline void
-LpReassembler::setOptions(const Options& options)
-{
-  m_options = options;
-}
-
 inline const LinkService*
 LpReassembler::getLinkService() const
 {
@@ -151,7 +191,7 @@ LpReassembler::getLinkService() const
 inline size_t
 LpReassembler::size() const
 {
-  return m_partialPackets.size();
+  return m_nPartialPackets;
 }
 
 } // namespace face
@@ -146,6 +146,12 @@ Transport::setPersistency(ndn::nfd::FacePersistency newPersistency)
   m_persistency = newPersistency;
 }
 
+ssize_t
+Transport::getSendQueueLength()
+{
+  return QUEUE_UNSUPPORTED;
+}
+
 void
 Transport::setState(TransportState newState)
 {
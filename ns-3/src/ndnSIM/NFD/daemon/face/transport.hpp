@@ -98,6 +98,10 @@ const ssize_t MTU_UNLIMITED = -1;
  */
 const ssize_t MTU_INVALID = -2;
 
+/** \brief indicates that the transport does not support reading the queue capacity/length
+ */
+const ssize_t QUEUE_UNSUPPORTED = -1;
+
 /** \brief the lower part of a Face
  *  \sa Face
  */
@@ -244,6 +248,14 @@ public: // static properties
   getMtu() const;
 
 public: // dynamic properties
+  /** \return current send queue length of the transport (in bytes)
+   *  \retval QUEUE_UNSUPPORTED transport does not support queue length retrieval
+   *
+   *  The default implementation returns QUEUE_UNSUPPORTED.
+   */
+  virtual ssize_t
+  getSendQueueLength();
+
   /** \return transport state
    */
   TransportState
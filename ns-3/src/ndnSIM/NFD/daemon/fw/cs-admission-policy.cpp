@@ -0,0 +1,260 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-admission-policy.hpp"
+#include "core/random.hpp"
+
+namespace nfd {
+namespace fw {
+
+CsAdmissionPolicy::Registry&
+CsAdmissionPolicy::getRegistry()
+{
+  static Registry registry;
+  return registry;
+}
+
+unique_ptr<CsAdmissionPolicy>
+CsAdmissionPolicy::create(const std::string& key, const ConfigSection& section)
+{
+  Registry& registry = getRegistry();
+  auto i = registry.find(key);
+  return i == registry.end() ? nullptr : i->second(section);
+}
+
+/** \return value of option \p key in the "cs_admission" section, or \p defaultValue if absent
+ */
+template<typename T>
+static T
+parseOption(const ConfigSection& section, const std::string& key, T defaultValue)
+{
+  boost::optional<const ConfigSection&> node = section.get_child_optional(key);
+  if (!node) {
+    return defaultValue;
+  }
+  return ConfigFile::parseNumber<T>(*node, key, "tables.cs_admission");
+}
+
+static double
+parseProbability(const ConfigSection& section, const std::string& key, double defaultValue)
+{
+  double probability = parseOption<double>(section, key, defaultValue);
+  if (probability < 0.0 || probability > 1.0) {
+    BOOST_THROW_EXCEPTION(ConfigFile::Error("Option \"" + key + "\" in \"tables.cs_admission\" "
+                                            "section must be between 0 and 1"));
+  }
+  return probability;
+}
+
+/** \return value of yes/no option \p key in the "cs_admission" section, or \p defaultValue if absent
+ */
+static bool
+parseFlag(const ConfigSection& section, const std::string& key, bool defaultValue)
+{
+  boost::optional<const ConfigSection&> node = section.get_child_optional(key);
+  if (!node) {
+    return defaultValue;
+  }
+  return ConfigFile::parseYesNo(*node, key, "tables.cs_admission");
+}
+
+NFD_REGISTER_CS_ADMISSION_POLICY(AdmitAllCsAdmissionPolicy, "admit-all");
+
+AdmitAllCsAdmissionPolicy::AdmitAllCsAdmissionPolicy(const ConfigSection& section)
+{
+}
+
+bool
+AdmitAllCsAdmissionPolicy::admit(const Face& inFace, const Data& data,
+                                 const pit::DataMatchResult& pitMatches)
+{
+  return true;
+}
+
+NFD_REGISTER_CS_ADMISSION_POLICY(ProbabilisticCsAdmissionPolicy, "probabilistic");
+
+const double ProbabilisticCsAdmissionPolicy::DEFAULT_PROBABILITY = 0.5;
+
+ProbabilisticCsAdmissionPolicy::ProbabilisticCsAdmissionPolicy(double probability)
+  : m_dist(probability)
+{
+}
+
+ProbabilisticCsAdmissionPolicy::ProbabilisticCsAdmissionPolicy(const ConfigSection& section)
+  : m_dist(parseProbability(section, "probability", DEFAULT_PROBABILITY))
+{
+}
+
+bool
+ProbabilisticCsAdmissionPolicy::admit(const Face& inFace, const Data& data,
+                                      const pit::DataMatchResult& pitMatches)
+{
+  return m_dist(getGlobalRng());
+}
+
+NFD_REGISTER_CS_ADMISSION_POLICY(TinyLfuCsAdmissionPolicy, "tinylfu");
+
+const size_t TinyLfuCsAdmissionPolicy::DEFAULT_WIDTH = 4096;
+const uint8_t TinyLfuCsAdmissionPolicy::DEFAULT_THRESHOLD = 2;
+const size_t TinyLfuCsAdmissionPolicy::DEPTH;
+
+TinyLfuCsAdmissionPolicy::TinyLfuCsAdmissionPolicy(size_t width, uint8_t threshold,
+                                                   size_t sampleSize)
+{
+  this->init(width, threshold, sampleSize);
+}
+
+TinyLfuCsAdmissionPolicy::TinyLfuCsAdmissionPolicy(const ConfigSection& section)
+{
+  size_t width = parseOption<size_t>(section, "width", DEFAULT_WIDTH);
+  unsigned threshold = parseOption<unsigned>(section, "threshold", DEFAULT_THRESHOLD);
+  if (width == 0 || threshold == 0 || threshold > std::numeric_limits<uint8_t>::max()) {
+    BOOST_THROW_EXCEPTION(ConfigFile::Error("Options \"width\" and \"threshold\" in "
+                                            "\"tables.cs_admission\" section are out of range"));
+  }
+  this->init(width, static_cast<uint8_t>(threshold),
+             parseOption<size_t>(section, "sample_size", 0));
+}
+
+void
+TinyLfuCsAdmissionPolicy::init(size_t width, uint8_t threshold, size_t sampleSize)
+{
+  BOOST_ASSERT(width > 0);
+  size_t rowSize = 1;
+  while (rowSize < width) {
+    rowSize <<= 1;
+  }
+
+  m_counters.assign(DEPTH * rowSize, 0);
+  m_mask = rowSize - 1;
+  m_threshold = threshold;
+  m_sampleSize = sampleSize > 0 ? sampleSize : 10 * rowSize;
+  m_nArrivals = 0;
+}
+
+size_t
+TinyLfuCsAdmissionPolicy::getIndex(size_t hash, size_t row) const
+{
+  // double hashing derives the counter of each row from one hash of the name
+  size_t step = (hash >> 16) | 1;
+  return row * (m_mask + 1) + ((hash + row * step) & m_mask);
+}
+
+uint8_t
+TinyLfuCsAdmissionPolicy::estimate(const Name& name) const
+{
+  size_t hash = std::hash<Name>()(name);
+  uint8_t count = std::numeric_limits<uint8_t>::max();
+  for (size_t row = 0; row < DEPTH; ++row) {
+    count = std::min(count, m_counters[this->getIndex(hash, row)]);
+  }
+  return count;
+}
+
+uint8_t
+TinyLfuCsAdmissionPolicy::increment(const Name& name)
+{
+  size_t hash = std::hash<Name>()(name);
+  size_t indices[DEPTH];
+  uint8_t count = std::numeric_limits<uint8_t>::max();
+  for (size_t row = 0; row < DEPTH; ++row) {
+    indices[row] = this->getIndex(hash, row);
+    count = std::min(count, m_counters[indices[row]]);
+  }
+
+  // conservative update: only counters at the minimum are increased,
+  // which limits the overestimation caused by collisions
+  if (count < std::numeric_limits<uint8_t>::max()) {
+    for (size_t row = 0; row < DEPTH; ++row) {
+      if (m_counters[indices[row]] == count) {
+        ++m_counters[indices[row]];
+      }
+    }
+    ++count;
+  }
+
+  if (++m_nArrivals >= m_sampleSize) {
+    this->age();
+  }
+  return count;
+}
+
+void
+TinyLfuCsAdmissionPolicy::age()
+{
+  for (uint8_t& counter : m_counters) {
+    counter >>= 1;
+  }
+  m_nArrivals /= 2;
+}
+
+bool
+TinyLfuCsAdmissionPolicy::admit(const Face& inFace, const Data& data,
+                                const pit::DataMatchResult& pitMatches)
+{
+  return this->increment(data.getName()) >= m_threshold;
+}
+
+NFD_REGISTER_CS_ADMISSION_POLICY(SfcCsAdmissionPolicy, "sfc");
+
+SfcCsAdmissionPolicy::SfcCsAdmissionPolicy(double transitProbability, bool isFunctionNode)
+  : m_transitDist(transitProbability)
+  , m_isFunctionNode(isFunctionNode)
+{
+}
+
+SfcCsAdmissionPolicy::SfcCsAdmissionPolicy(const ConfigSection& section)
+  : m_transitDist(parseProbability(section, "admit_transit", 0.0))
+  , m_isFunctionNode(parseFlag(section, "function_node", false))
+{
+}
+
+bool
+SfcCsAdmissionPolicy::admit(const Face& inFace, const Data& data,
+                            const pit::DataMatchResult& pitMatches)
+{
+  // function instances are forwarder nodes, which receive Data on non-local faces
+  if (m_isFunctionNode) {
+    return true;
+  }
+
+  // producers and consumers are attached through local faces
+  if (inFace.getScope() == ndn::nfd::FACE_SCOPE_LOCAL) {
+    return true;
+  }
+
+  for (const shared_ptr<pit::Entry>& pitEntry : pitMatches) {
+    for (const pit::InRecord& inRecord : pitEntry->getInRecords()) {
+      if (inRecord.getFace().getScope() == ndn::nfd::FACE_SCOPE_LOCAL) {
+        return true;
+      }
+    }
+  }
+
+  return m_transitDist(getGlobalRng());
+}
+
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,233 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef NFD_DAEMON_FW_CS_ADMISSION_POLICY_HPP
+#define NFD_DAEMON_FW_CS_ADMISSION_POLICY_HPP
+
+#include "face/face.hpp"
+#include "table/pit.hpp"
+#include "core/config-file.hpp"
+
+#include <random>
+
+namespace nfd {
+namespace fw {
+
+/** \brief decides whether a Data that satisfied pending Interests is inserted into the ContentStore
+ *
+ *  The incoming Data pipeline asks this policy before each ContentStore insertion,
+ *  so that a node can skip caching Data that is better cached elsewhere or unlikely to be
+ *  requested again. A rejected Data is still forwarded downstream.
+ */
+class CsAdmissionPolicy : noncopyable
+{
+public:
+  virtual ~CsAdmissionPolicy() = default;
+
+  /** \param inFace face on which \p data arrived
+   *  \param pitMatches PIT entries satisfied by \p data, not empty
+   *  \return whether \p data should be inserted into the ContentStore
+   */
+  virtual bool
+  admit(const Face& inFace, const Data& data, const pit::DataMatchResult& pitMatches) = 0;
+
+public: // registry
+  template<typename P>
+  static void
+  registerPolicy(const std::string& key)
+  {
+    Registry& registry = getRegistry();
+    BOOST_ASSERT(registry.count(key) == 0);
+    registry[key] = [] (const ConfigSection& section) { return make_unique<P>(section); };
+  }
+
+  /** \return a CsAdmissionPolicy identified by \p key, or nullptr if \p key is unknown
+   *  \param section options of the policy, i.e. the "cs_admission" subsection of "tables"
+   *  \throw ConfigFile::Error an option is invalid
+   */
+  static unique_ptr<CsAdmissionPolicy>
+  create(const std::string& key, const ConfigSection& section);
+
+private:
+  typedef std::function<unique_ptr<CsAdmissionPolicy>(const ConfigSection&)> CreateFunc;
+  typedef std::map<std::string, CreateFunc> Registry; // indexed by key
+
+  static Registry&
+  getRegistry();
+};
+
+/** \brief admits all Data
+ */
+class AdmitAllCsAdmissionPolicy : public CsAdmissionPolicy
+{
+public:
+  AdmitAllCsAdmissionPolicy() = default;
+
+  explicit
+  AdmitAllCsAdmissionPolicy(const ConfigSection& section);
+
+  virtual bool
+  admit(const Face& inFace, const Data& data, const pit::DataMatchResult& pitMatches) final;
+};
+
+/** \brief admits each Data with a fixed probability
+ *
+ *  Option: probability (default 0.5)
+ */
+class ProbabilisticCsAdmissionPolicy : public CsAdmissionPolicy
+{
+public:
+  explicit
+  ProbabilisticCsAdmissionPolicy(double probability = DEFAULT_PROBABILITY);
+
+  explicit
+  ProbabilisticCsAdmissionPolicy(const ConfigSection& section);
+
+  virtual bool
+  admit(const Face& inFace, const Data& data, const pit::DataMatchResult& pitMatches) final;
+
+public:
+  static const double DEFAULT_PROBABILITY;
+
+private:
+  std::bernoulli_distribution m_dist;
+};
+
+/** \brief admits Data whose name arrived often enough recently, as estimated by TinyLFU
+ *
+ *  Arrivals of each Data name are counted in a count-min sketch of 4 rows of 8-bit counters.
+ *  A Data is admitted when its estimated count, including this arrival, reaches the threshold.
+ *  After as many arrivals as the sample size, all counters are halved, so that the estimates
+ *  follow recent popularity; with the default threshold, a name has to arrive twice within
+ *  about one sample to be cached.
+ *
+ *  Since only Data that missed this node's ContentStore arrives here, a name that keeps
+ *  being requested but is not cached keeps being counted.
+ *
+ *  Options: width (counters per row, rounded up to a power of two, default 4096),
+ *  threshold (default 2), sample_size (default 10 times the width)
+ */
+class TinyLfuCsAdmissionPolicy : public CsAdmissionPolicy
+{
+public:
+  explicit
+  TinyLfuCsAdmissionPolicy(size_t width = DEFAULT_WIDTH, uint8_t threshold = DEFAULT_THRESHOLD,
+                           size_t sampleSize = 0);
+
+  explicit
+  TinyLfuCsAdmissionPolicy(const ConfigSection& section);
+
+  virtual bool
+  admit(const Face& inFace, const Data& data, const pit::DataMatchResult& pitMatches) final;
+
+  /** \return estimated number of recent arrivals of \p name
+   */
+  uint8_t
+  estimate(const Name& name) const;
+
+public:
+  static const size_t DEFAULT_WIDTH;
+  static const uint8_t DEFAULT_THRESHOLD;
+  static const size_t DEPTH = 4;
+
+private:
+  void
+  init(size_t width, uint8_t threshold, size_t sampleSize);
+
+  size_t
+  getIndex(size_t hash, size_t row) const;
+
+  /** \brief count an arrival of \p name
+   *  \return estimated count including this arrival
+   */
+  uint8_t
+  increment(const Name& name);
+
+  /** \brief halve all counters
+   */
+  void
+  age();
+
+private:
+  std::vector<uint8_t> m_counters; ///< DEPTH rows of m_mask + 1 counters
+  size_t m_mask;
+  uint8_t m_threshold;
+  size_t m_sampleSize;
+  size_t m_nArrivals;
+};
+
+/** \brief admits Data only on function instance nodes and where an application is attached
+ *
+ *  Every Data is admitted on a node that runs a function instance. Function instances are
+ *  forwarder nodes rather than applications, so their Data arrives on non-local faces and the
+ *  node has to be marked with the function_node option. On other nodes, a Data is admitted if
+ *  it arrived from a local face, i.e. it was produced by a producer on this node, or if a
+ *  satisfied PIT entry has an in-record of a local face, i.e. this node is the edge node of a
+ *  consumer. Routers in between keep their ContentStore for Data that is requested through
+ *  them by several edges.
+ *
+ *  Options: function_node (yes/no, default no), whether this node runs a function instance;
+ *  admit_transit (default 0), probability of admitting other Data
+ */
+class SfcCsAdmissionPolicy : public CsAdmissionPolicy
+{
+public:
+  explicit
+  SfcCsAdmissionPolicy(double transitProbability = 0.0, bool isFunctionNode = false);
+
+  explicit
+  SfcCsAdmissionPolicy(const ConfigSection& section);
+
+  virtual bool
+  admit(const Face& inFace, const Data& data, const pit::DataMatchResult& pitMatches) final;
+
+private:
+  std::bernoulli_distribution m_transitDist;
+  bool m_isFunctionNode;
+};
+
+/** \brief the default CsAdmissionPolicy
+ */
+typedef AdmitAllCsAdmissionPolicy DefaultCsAdmissionPolicy;
+
+} // namespace fw
+} // namespace nfd
+
+/** \brief registers a ContentStore admission policy
+ *  \param P a subclass of nfd::fw::CsAdmissionPolicy, constructible from a ConfigSection
+ *  \param key the policy keyword, which is available for selection in NFD config file
+ */
+#define NFD_REGISTER_CS_ADMISSION_POLICY(P, key)                \
+static class NfdAuto ## P ## CsAdmissionPolicyRegistrationClass \
+{                                                               \
+public:                                                         \
+  NfdAuto ## P ## CsAdmissionPolicyRegistrationClass()          \
+  {                                                             \
+    ::nfd::fw::CsAdmissionPolicy::registerPolicy<P>(key);       \
+  }                                                             \
+} g_nfdAuto ## P ## CsAdmissionPolicyRegistrationVariable
+
+#endif // NFD_DAEMON_FW_CS_ADMISSION_POLICY_HPP
@@ -31,6 +31,7 @@
 #include "ns3/simulator.h"
 #include <ndn-cxx/lp/tags.hpp>
 #include "face/null-face.hpp"
+#include "ns3/ndnSIM/model/cs/content-store-nfd.hpp"
 #include <boost/random/uniform_int_distribution.hpp>
 #include <chrono>
 #include <thread>
@@ -41,14 +42,21 @@ NFD_LOG_INIT("Forwarder");
 
 Forwarder::Forwarder()
 : m_unsolicitedDataPolicy(new fw::DefaultUnsolicitedDataPolicy())
+, m_csAdmissionPolicy(new fw::DefaultCsAdmissionPolicy())
 , m_fib(m_nameTree)
 , m_pit(m_nameTree)
 , m_measurements(m_nameTree)
 , m_strategyChoice(m_nameTree, fw::makeDefaultStrategy(*this))
 , m_csFace(face::makeNullFace(FaceUri("contentstore://")))
+, m_isLoopDetectionEnabled(false)
+, m_isMeasuredInstanceSelectionEnabled(false)
+, m_sfcMeasurements(m_fib, m_measurements)
+, m_isInterestBatchingEnabled(false)
+, m_contentStore(ns3::CreateObject<ns3::ndn::cs::Nfd>(&m_cs))
+, m_isCacheHitFastPathEnabled(false)
 {
 	m_resetTime = time::toUnixTimestamp(time::system_clock::now());
-	fw::installStrategies(*this);
+	m_strategyChoice.enableOnDemandInstallation(*this);
 	getFaceTable().addReserved(m_csFace, face::FACEID_CONTENT_STORE);
 
 	m_faceTable.afterAdd.connect([this] (Face& face) {
@@ -89,15 +97,66 @@ Forwarder::startProcessInterest(Face& face, const Interest& interest)
 		return;
 	}
 
+	if (m_isInterestBatchingEnabled) {
+		if (m_interestBatch.empty()) {
+			m_interestBatchEvent = scheduler::schedule(time::nanoseconds::zero(),
+					bind(&Forwarder::processInterestBatch, this));
+		}
+		m_interestBatch.emplace_back(face.getId(), interest.shared_from_this());
+		return;
+	}
+
 	this->onIncomingInterest(face, interest);
 }
 
+void
+Forwarder::processInterestBatch()
+{
+	m_interestBatchEvent.cancel();
+
+	// Interests received while the batch is processed go into a new batch
+	std::vector<std::pair<FaceId, shared_ptr<const Interest>>> batch;
+	batch.swap(m_interestBatch);
+
+	for (const auto& item : batch) {
+		m_nameTree.prefetch(item.second->getName());
+	}
+
+	for (const auto& item : batch) {
+		Face* face = m_faceTable.get(item.first);
+		if (face == nullptr) {
+			// face was removed after the Interest was received
+			continue;
+		}
+		this->onIncomingInterest(*face, *item.second);
+	}
+
+	if (m_interestBatch.empty()) {
+		// reuse the allocated capacity for the next batch
+		batch.clear();
+		m_interestBatch.swap(batch);
+	}
+}
+
+void
+Forwarder::setInterestBatchingEnabled(bool isEnabled)
+{
+	m_isInterestBatchingEnabled = isEnabled;
+	if (!isEnabled && !m_interestBatch.empty()) {
+		this->processInterestBatch();
+	}
+}
+
 void
 Forwarder::startProcessData(Face& face, const Data& data)
 {
 	// check fields used by forwarding are well-formed
 	// (none needed)
 
+	if (!m_interestBatch.empty()) {
+		this->processInterestBatch();
+	}
+
 	this->onIncomingData(face, data);
 }
 
@@ -117,6 +176,10 @@ Forwarder::startProcessNack(Face& face, const lp::Nack& nack)
 		return;
 	}
 
+	if (!m_interestBatch.empty()) {
+		this->processInterestBatch();
+	}
+
 	this->onIncomingNack(face, nack);
 }
 
@@ -140,30 +203,42 @@ Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
 	}
 
 	// detect duplicate Nonce with Dead Nonce List
-	bool hasDuplicateNonceInDnl = m_deadNonceList.has(interest.getName(), interest.getNonce());
+	if (m_isLoopDetectionEnabled) {
+		bool hasDuplicateNonceInDnl = m_deadNonceList.has(interest.getName(), interest.getNonce());
+		if (hasDuplicateNonceInDnl) {
+			// goto Interest loop pipeline
+			this->onInterestLoop(inFace, interest);
+			return;
+		}
+	}
 
-	/*
-  if (hasDuplicateNonceInDnl) {
-    // goto Interest loop pipeline
-    this->onInterestLoop(inFace, interest);
-    return;
-  }
-	 */
+	// cache-hit fast path: without PIT entry, there is no pending Interest or Nonce to check
+	if (m_isCacheHitFastPathEnabled && m_pit.find(interest) == nullptr) {
+		shared_ptr<const Data> match = m_contentStore->Lookup(interest.shared_from_this());
+		if (match != nullptr) {
+			this->onContentStoreHitWithoutPit(inFace, interest, *match);
+			return;
+		}
+
+		// the new PIT entry is not pending, and the content store has been looked up already
+		shared_ptr<pit::Entry> pitEntry = m_pit.insert(interest).first;
+		this->onContentStoreMiss(inFace, pitEntry, interest);
+		return;
+	}
 
 	// PIT insert
 	shared_ptr<pit::Entry> pitEntry = m_pit.insert(interest).first;
 
 	// detect duplicate Nonce in PIT entry
-	bool hasDuplicateNonceInPit = fw::findDuplicateNonce(*pitEntry, interest.getNonce(), inFace) !=
-			fw::DUPLICATE_NONCE_NONE;
-
-	/*
-  if (hasDuplicateNonceInPit) {
-    // goto Interest loop pipeline
-    this->onInterestLoop(inFace, interest);
-    return;
-  }
-	 */
+	if (m_isLoopDetectionEnabled) {
+		bool hasDuplicateNonceInPit = fw::findDuplicateNonce(*pitEntry, interest.getNonce(), inFace) !=
+				fw::DUPLICATE_NONCE_NONE;
+		if (hasDuplicateNonceInPit) {
+			// goto Interest loop pipeline
+			this->onInterestLoop(inFace, interest);
+			return;
+		}
+	}
 
 	// cancel unsatisfy & straggler timer
 	this->cancelUnsatisfyAndStragglerTimer(*pitEntry);
@@ -171,19 +246,12 @@ Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
 	const pit::InRecordCollection& inRecords = pitEntry->getInRecords();
 	bool isPending = inRecords.begin() != inRecords.end();
 	if (!isPending) {
-		if (m_csFromNdnSim == nullptr) {
-			m_cs.find(interest,
-					bind(&Forwarder::onContentStoreHit, this, ref(inFace), pitEntry, _1, _2),
-					bind(&Forwarder::onContentStoreMiss, this, ref(inFace), pitEntry, _1));
+		shared_ptr<const Data> match = m_contentStore->Lookup(interest.shared_from_this());
+		if (match != nullptr) {
+			this->onContentStoreHit(inFace, pitEntry, interest, *match);
 		}
 		else {
-			shared_ptr<Data> match = m_csFromNdnSim->Lookup(interest.shared_from_this());
-			if (match != nullptr) {
-				this->onContentStoreHit(inFace, pitEntry, interest, *match);
-			}
-			else {
-				this->onContentStoreMiss(inFace, pitEntry, interest);
-			}
+			this->onContentStoreMiss(inFace, pitEntry, interest);
 		}
 	}
 	else {
@@ -1090,7 +1158,6 @@ Forwarder::onContentStoreMiss(const Face& inFace, const shared_ptr<pit::Entry> p
 	}
 
 	fib::Entry* fibEntry;
-	Face* nextHopFaceFunction;
 	if(functionName2.toUri() != "/"){ //When Function Field is not Empty
 		//std::cout << "function routing" << std::endl;
 		if(ns3::getChoiceType() == 4){
@@ -1102,7 +1169,7 @@ Forwarder::onContentStoreMiss(const Face& inFace, const shared_ptr<pit::Entry> p
 				funcStr = "/F1";
 				interest.replaceHeadFunction(interest,make_shared<std::string>(funcStr));
 				functionName2 = interest.getFunction();
-				fibEntry = m_fib.selectFunction(functionName2);
+				fibEntry = this->selectFunctionInstance(functionName2, pitEntry);
 				pitEntry->setSelectedInstance(fibEntry);
 				//std::cout<<"instanceSET1" << pitEntry->getSelectedInstance()<<std::endl;
 				interest.setFunctionNextName(Name(fibEntry->getPrefix().toUri()));
@@ -1112,7 +1179,7 @@ Forwarder::onContentStoreMiss(const Face& inFace, const shared_ptr<pit::Entry> p
 				funcStr = "/F2";
 				interest.replaceHeadFunction(interest,make_shared<std::string>(funcStr));
 				functionName2 = interest.getFunction();
-				fibEntry = m_fib.selectFunction(functionName2);
+				fibEntry = this->selectFunctionInstance(functionName2, pitEntry);
 				pitEntry->setSelectedInstance(fibEntry);
 				//std::cout<<"instanceSET2" << pitEntry->getSelectedInstance()<<std::endl;
 				interest.setFunctionNextName(Name(fibEntry->getPrefix().toUri()));
@@ -1122,7 +1189,7 @@ Forwarder::onContentStoreMiss(const Face& inFace, const shared_ptr<pit::Entry> p
 				funcStr = "/F3";
 				interest.replaceHeadFunction(interest,make_shared<std::string>(funcStr));
 				functionName2 = interest.getFunction();
-				fibEntry = m_fib.selectFunction(functionName2);
+				fibEntry = this->selectFunctionInstance(functionName2, pitEntry);
 				pitEntry->setSelectedInstance(fibEntry);
 				//std::cout<<"instanceSET3" << pitEntry->getSelectedInstance()<<std::endl;
 				interest.setFunctionNextName(Name(fibEntry->getPrefix().toUri()));
@@ -1132,7 +1199,7 @@ Forwarder::onContentStoreMiss(const Face& inFace, const shared_ptr<pit::Entry> p
 				funcStr = "/F4";
 				interest.replaceHeadFunction(interest,make_shared<std::string>(funcStr));
 				functionName2 = interest.getFunction();
-				fibEntry = m_fib.selectFunction(functionName2);
+				fibEntry = this->selectFunctionInstance(functionName2, pitEntry);
 				pitEntry->setSelectedInstance(fibEntry);
 				interest.setFunctionNextName(Name(fibEntry->getPrefix().toUri()));
 				interest.addFunctionFullName(Name(fibEntry->getPrefix().toUri()));
@@ -1141,7 +1208,7 @@ Forwarder::onContentStoreMiss(const Face& inFace, const shared_ptr<pit::Entry> p
 				funcStr = "/F5";
 				interest.replaceHeadFunction(interest,make_shared<std::string>(funcStr));
 				functionName2 = interest.getFunction();
-				fibEntry = m_fib.selectFunction(functionName2);
+				fibEntry = this->selectFunctionInstance(functionName2, pitEntry);
 				pitEntry->setSelectedInstance(fibEntry);
 				interest.setFunctionNextName(Name(fibEntry->getPrefix().toUri()));
 				interest.addFunctionFullName(Name(fibEntry->getPrefix().toUri()));
@@ -1245,13 +1312,11 @@ Forwarder::onContentStoreMiss(const Face& inFace, const shared_ptr<pit::Entry> p
 
 		if(fibEntry != nullptr){ //When there is matching FIB route
 			//std::cout<<"LPM FIB Route: "<<fibEntry->getPrefix()<<std::endl;
-			for(auto it : fibEntry->getNextHops()){
-				nextHopFaceFunction = &it.getFace();
-				//std::cout<< "Passed: "<<interest.getNonce()<<std::endl;
-
-				//interest.removeHeadFunction(interest);
-				//Go to OutGoingInterest Pipeline
-				this->onOutgoingInterest(pitEntry, *nextHopFaceFunction, interest);
+			// dispatch to strategy: the strategy picks the nexthops toward the function instance
+			this->dispatchToStrategy(*pitEntry,
+					[&] (fw::Strategy& strategy) { strategy.afterReceiveFunctionInterest(inFace, interest, *fibEntry, pitEntry); });
+			if (m_isMeasuredInstanceSelectionEnabled) {
+				this->sendInstanceProbe(inFace, interest, *fibEntry, pitEntry);
 			}
 			return;
 
@@ -1281,6 +1346,71 @@ Forwarder::onContentStoreMiss(const Face& inFace, const shared_ptr<pit::Entry> p
 			[&] (fw::Strategy& strategy) { strategy.afterReceiveInterest(inFace, interest, pitEntry); });
 }
 
+fib::Entry*
+Forwarder::selectFunctionInstance(const Name& function, const shared_ptr<pit::Entry>& pitEntry)
+{
+	if (m_isMeasuredInstanceSelectionEnabled) {
+		// instances are named after the head function only, as in Fib::selectFunction
+		fib::Entry* instance = m_sfcMeasurements.selectInstance(function.getPrefix(1), *pitEntry);
+		if (instance != nullptr) {
+			instance->setFcc(instance->getFcc() + 1);
+			return instance;
+		}
+	}
+	return m_fib.selectFunction(function);
+}
+
+void
+Forwarder::sendInstanceProbe(const Face& inFace, const Interest& interest,
+		const fib::Entry& selected, const shared_ptr<pit::Entry>& pitEntry)
+{
+	fib::Entry* probeInstance = m_sfcMeasurements.takeProbeInstance(*pitEntry);
+	if (probeInstance == nullptr || probeInstance == &selected) {
+		return;
+	}
+
+	// a probe sharing an upstream with the call itself could not be told apart from it
+	Face* probeFace = nullptr;
+	for (const fib::NextHop& nexthop : probeInstance->getNextHops()) {
+		Face& face = nexthop.getFace();
+		if (&face != &inFace && pitEntry->getOutRecord(face) == pitEntry->out_end()) {
+			probeFace = &face;
+			break;
+		}
+	}
+	if (probeFace == nullptr) {
+		return;
+	}
+
+	// the chain is the same, only the selected instance is replaced
+	shared_ptr<Interest> probe = make_shared<Interest>(interest);
+	probe->refreshNonce();
+	probe->setFunctionNextName(probeInstance->getPrefix());
+	probe->setFunctionFullName(Name(probeInstance->getPrefix())
+			.append(interest.getFunctionFullName().getSubName(selected.getPrefix().size())));
+
+	NFD_LOG_DEBUG("sendInstanceProbe interest=" << interest.getName() <<
+			" instance=" << probeInstance->getPrefix() << " face=" << probeFace->getId());
+	this->onOutgoingInterest(pitEntry, *probeFace, *probe);
+}
+
+/** \brief prepare a Data from the content store to be returned for \p interest
+ *
+ *  \p data is the cached packet itself, so tags left by the hop that inserted it
+ *  or by a previous hit are reset.
+ */
+static void
+resetCachedData(const Interest& interest, const Data& data)
+{
+	data.setServiceTime(interest.getServiceTime());
+	data.setTag<lp::FunctionNameTag>(nullptr);
+	data.setTag<lp::PartialHopTag>(nullptr);
+	data.setTag<lp::CountTag>(nullptr);
+	data.setTag<lp::HopCountTag>(nullptr);
+	// a congestion mark describes the path the Data was fetched over, not the cache
+	data.setTag<lp::CongestionMarkTag>(nullptr);
+}
+
 void
 Forwarder::onContentStoreHit(const Face& inFace, const shared_ptr<pit::Entry>& pitEntry,
 		const Interest& interest, const Data& data)
@@ -1289,10 +1419,7 @@ Forwarder::onContentStoreHit(const Face& inFace, const shared_ptr<pit::Entry>& p
 	//std::cout << "aaaaaaaaaaaaaaaaaHITaaaaaaaaaaaaaaaaaaaaaaa" << std::endl;
 	// std::cout << "CachHitInterest =" << interest.getName() << std::endl;
 	// std::cout << "CachHitServiceTime =" << interest.getServiceTime() << std::endl;
-	data.setServiceTime(interest.getServiceTime());
-	data.setTag<lp::FunctionNameTag>(nullptr);
-	data.setTag<lp::PartialHopTag>(nullptr);
-	data.setTag<lp::CountTag>(nullptr);
+	resetCachedData(interest, data);
 	
 	//m_cs.update();
 	
@@ -1312,6 +1439,26 @@ Forwarder::onContentStoreHit(const Face& inFace, const shared_ptr<pit::Entry>& p
 	this->onOutgoingData(data, *const_pointer_cast<Face>(inFace.shared_from_this()));
 }
 
+void
+Forwarder::onContentStoreHitWithoutPit(const Face& inFace, const Interest& interest,
+		const Data& data)
+{
+	NFD_LOG_DEBUG("onContentStoreHitWithoutPit interest=" << interest.getName());
+	resetCachedData(interest, data);
+
+	// the entry is not inserted into the PIT, so it exists only for tracers and the strategy,
+	// whose effective strategy is found by name instead of through the NameTree entry
+	auto pitEntry = make_shared<pit::Entry>(interest);
+	beforeSatisfyInterest(*pitEntry, *m_csFace, data);
+	m_strategyChoice.findEffectiveStrategy(interest.getName())
+			.beforeSatisfyInterest(pitEntry, *m_csFace, data);
+
+	data.setTag(make_shared<lp::IncomingFaceIdTag>(face::FACEID_CONTENT_STORE));
+
+	// goto outgoing Data pipeline
+	this->onOutgoingData(data, *const_pointer_cast<Face>(inFace.shared_from_this()));
+}
+
 void
 Forwarder::onOutgoingInterest(const shared_ptr<pit::Entry>& pitEntry, Face& outFace, const Interest& interest)
 {
@@ -1321,6 +1468,10 @@ Forwarder::onOutgoingInterest(const shared_ptr<pit::Entry>& pitEntry, Face& outF
 	// insert out-record
 	pitEntry->insertOrUpdateOutRecord(outFace, interest);
 
+	if (m_isMeasuredInstanceSelectionEnabled && !interest.getFunctionNextName().empty()) {
+		m_sfcMeasurements.afterSendInterest(*pitEntry, outFace, interest.getFunctionNextName());
+	}
+
 	/*
   int currentNode = getNode()->GetId();
 
@@ -1373,6 +1524,10 @@ Forwarder::onInterestFinalize(const shared_ptr<pit::Entry>& pitEntry, bool isSat
 	NFD_LOG_DEBUG("onInterestFinalize interest=" << pitEntry->getName() <<
 			(isSatisfied ? " satisfied" : " unsatisfied"));
 
+	if (m_isMeasuredInstanceSelectionEnabled) {
+		m_sfcMeasurements.beforeFinalize(*pitEntry, isSatisfied);
+	}
+
 	// Dead Nonce List insert if necessary
 	this->insertDeadNonceList(*pitEntry, isSatisfied, dataFreshnessPeriod, 0);
 
@@ -2110,58 +2265,31 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
 		return;
 	}
 
-///*
-	time::nanoseconds Nowtime;
-	time::nanoseconds time2temp;
-  	time::steady_clock::TimePoint dataBackTime;
-
-  for (const shared_ptr<pit::Entry>& pitEntry : pitMatches) {
-    const pit::OutRecordCollection& outRecords = pitEntry->getOutRecords();
-    for (pit::OutRecordCollection::const_iterator it = outRecords.begin();
-                                                  it != outRecords.end(); ++it) {
-      dataBackTime = time::steady_clock::now();
-	  Nowtime = time::duration_cast<time::nanoseconds>(dataBackTime.time_since_epoch());
-	  
-	  //std::cout << Nowtime << std::endl;
-	  //std::cout << dataBackTime << std::endl;
-      //std::cout << it->getLastRenewed() << std::endl;
-      //time2temp = (dataBackTime - it->getLastRenewed() - time::nanoseconds(1000000))/2;
-      time2temp = (dataBackTime - it->getLastRenewed())/2; //latency
-	  //std::cout << time2temp << std::endl;
-	  //std::cout << it->getLastRenewed() << std::endl; 
-    }
-  }
-  
-//  time::nanoseconds time1temp = time::nanoseconds(data.getFreshnessPeriod());
-//  int time1 = time1temp.count();
-  long long time2 = time2temp.count(); //latency
-  long long Now = Nowtime.count(); //currenttime
-//*/
-//std::cout << "data" << data << std::endl;
-//std::cout << "time1: " << time1 << std::endl;
-//std::cout << "latency:" << time2 << std::endl;
-//std::cout << "CunrrentTime: " << Now << std::endl;
-
-	//std::cout << "PIT Matches: " << pitMatches.size() << std::endl;
-
-	shared_ptr<Data> dataCopyWithoutTag = make_shared<Data>(data);
-	//std::cout << "data" << *dataCopyWithoutTag << std::endl;
-	dataCopyWithoutTag->removeTag<lp::HopCountTag>();
+	// retrieval cost: round-trip time of the Interest sent to the upstream this Data came from,
+	// in simulated time; the clock is read once for the whole Data pipeline
+	auto now = time::steady_clock::now();
+	time::nanoseconds retrievalCost = time::nanoseconds::zero();
+	for (const shared_ptr<pit::Entry>& pitEntry : pitMatches) {
+		pit::OutRecordCollection::iterator outRecord = pitEntry->getOutRecord(inFace);
+		if (outRecord != pitEntry->out_end()) {
+			retrievalCost = now - outRecord->getLastRenewed();
+			break;
+		}
+	}
 
 	// CS insert
-	if (m_csFromNdnSim == nullptr){
-		//std::cout << "aaaaa" << std::endl;
-		m_cs.insert(*dataCopyWithoutTag,time2, Now);
+	// the cached Data is the one being forwarded: per-hop tags are reset on cache hits
+	if (m_csAdmissionPolicy->admit(inFace, data, pitMatches)) {
+		m_contentStore->Add(data.shared_from_this(), retrievalCost);
 	}
-	else{
-		//std::cout << "aaaaaaa" << std::endl; 
-		m_csFromNdnSim->Add(dataCopyWithoutTag, time2, Now);
+	else {
+		NFD_LOG_DEBUG("onIncomingData face=" << inFace.getId() << " data=" << data.getName() <<
+				" cs-admission=reject");
 	}
 	std::set<Face*> pendingDownstreams;
 	bool pitSatisfyFlag = true;
 	bool updateControlFlag = true;
 	// foreach PitEntry
-	auto now = time::steady_clock::now();
 
 	for (const shared_ptr<pit::Entry>& pitEntry : pitMatches) {
 		//std::cout<<"instanceSETdammy" << pitEntry->getSelectedInstance()<<std::endl;
@@ -2228,6 +2356,10 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
 		this->dispatchToStrategy(*pitEntry,
 				[&] (fw::Strategy& strategy) { strategy.beforeSatisfyInterest(pitEntry, inFace, data); });
 
+		if (m_isMeasuredInstanceSelectionEnabled) {
+			m_sfcMeasurements.beforeSatisfyInterest(*pitEntry, inFace);
+		}
+
 		// Dead Nonce List insert if necessary (for out-record of inFace)
 		this->insertDeadNonceList(*pitEntry, true, data.getFreshnessPeriod(), &inFace);
 
@@ -2271,10 +2403,7 @@ Forwarder::onDataUnsolicited(Face& inFace, const Data& data)
 	fw::UnsolicitedDataDecision decision = m_unsolicitedDataPolicy->decide(inFace, data);
 	if (decision == fw::UnsolicitedDataDecision::CACHE) {
 		// CS insert
-		if (m_csFromNdnSim == nullptr)
-			m_cs.insert(data, true);
-		else
-			m_csFromNdnSim->Add(data.shared_from_this());
+		m_contentStore->AddUnsolicited(data.shared_from_this());
 	}
 
 	NFD_LOG_DEBUG("onDataUnsolicited face=" << inFace.getId() <<
@@ -2462,6 +2591,11 @@ void
 Forwarder::insertDeadNonceList(pit::Entry& pitEntry, bool isSatisfied,
 		time::milliseconds dataFreshnessPeriod, Face* upstream)
 {
+	// Dead Nonce List is only consulted when loop detection is enabled
+	if (!m_isLoopDetectionEnabled) {
+		return;
+	}
+
 	// need Dead Nonce List insert?
 	bool needDnl = false;
 	if (isSatisfied) {
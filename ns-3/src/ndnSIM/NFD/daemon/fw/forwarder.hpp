@@ -31,6 +31,8 @@
 #include "forwarder-counters.hpp"
 #include "face-table.hpp"
 #include "unsolicited-data-policy.hpp"
+#include "cs-admission-policy.hpp"
+#include "sfc-measurements.hpp"
 #include "table/fib.hpp"
 #include "table/pit.hpp"
 #include "table/cs.hpp"
@@ -118,6 +120,19 @@ public: // faces and policies
 		m_unsolicitedDataPolicy = std::move(policy);
 	}
 
+	fw::CsAdmissionPolicy&
+	getCsAdmissionPolicy() const
+	{
+		return *m_csAdmissionPolicy;
+	}
+
+	void
+	setCsAdmissionPolicy(unique_ptr<fw::CsAdmissionPolicy> policy)
+	{
+		BOOST_ASSERT(policy != nullptr);
+		m_csAdmissionPolicy = std::move(policy);
+	}
+
 public: // forwarding entrypoints and tables
 	/** \brief start incoming Interest processing
 	 *  \param face face on which Interest is received
@@ -188,11 +203,109 @@ public: // forwarding entrypoints and tables
 		return m_networkRegionTable;
 	}
 
-public: // allow enabling ndnSIM content store (will be removed in the future)
+public: // loop detection
+	/** \brief enable or disable Interest loop detection
+	 *
+	 *  When disabled (the default), incoming Interests are not checked against the
+	 *  Dead Nonce List nor against Nonces in the PIT entry, and no Nonce is recorded in the
+	 *  Dead Nonce List. This allows function-chained Interests to revisit a node.
+	 *  When enabled, a duplicate Nonce goes to the Interest loop pipeline.
+	 */
+	void
+	setLoopDetectionEnabled(bool isEnabled)
+	{
+		m_isLoopDetectionEnabled = isEnabled;
+	}
+
+	bool
+	isLoopDetectionEnabled() const
+	{
+		return m_isLoopDetectionEnabled;
+	}
+
+public: // function instance selection
+	/** \brief enable or disable instance selection by measured service time
+	 *
+	 *  When enabled, fibControl selects the instance of a function whose measured SRTT,
+	 *  including function execution, is lowest, and periodically probes the other instances.
+	 *  When disabled (the default), or while no instance has been measured,
+	 *  the instance is selected by FIB cost as in Fib::selectFunction.
+	 */
+	void
+	setMeasuredInstanceSelectionEnabled(bool isEnabled)
+	{
+		m_isMeasuredInstanceSelectionEnabled = isEnabled;
+	}
+
+	bool
+	isMeasuredInstanceSelectionEnabled() const
+	{
+		return m_isMeasuredInstanceSelectionEnabled;
+	}
+
+	fw::sfc::SfcMeasurements&
+	getSfcMeasurements()
+	{
+		return m_sfcMeasurements;
+	}
+
+public: // Interest batching
+	/** \brief enable or disable batched processing of incoming Interests
+	 *
+	 *  When enabled, Interests received at the same simulated time are queued and processed
+	 *  together by a zero-delay event: the NameTree buckets of all their names are prefetched,
+	 *  then the incoming Interest pipeline runs for each of them in arrival order.
+	 *  Queued Interests are processed before an incoming Data or Nack,
+	 *  so that packets still enter the pipelines in the order they were received.
+	 *  When disabled (the default), each Interest is processed as soon as it is received.
+	 */
+	void
+	setInterestBatchingEnabled(bool isEnabled);
+
+	bool
+	isInterestBatchingEnabled() const
+	{
+		return m_isInterestBatchingEnabled;
+	}
+
+public: // content store
+	/** \brief content store used by the forwarding pipelines
+	 *
+	 *  By default this is an ns3::ndn::cs::Nfd interface to getCs().
+	 */
+	ns3::Ptr<ns3::ndn::ContentStore>
+	getContentStore() const
+	{
+		return m_contentStore;
+	}
+
+	/** \brief make the forwarding pipelines use \p cs, e.g. one of ndnSIM's content stores,
+	 *         instead of getCs()
+	 */
+	void
+	setContentStore(ns3::Ptr<ns3::ndn::ContentStore> cs)
+	{
+		m_contentStore = cs;
+	}
+
+	/** \brief enable or disable the cache-hit fast path
+	 *
+	 *  When enabled, an incoming Interest whose name has no PIT entry is looked up in the
+	 *  content store before a PIT entry is created.  On a hit, the Data is returned without
+	 *  inserting a PIT or NameTree entry and without scheduling a straggler timer;
+	 *  beforeSatisfyInterest and the strategy trigger still fire, with a PIT entry that is not
+	 *  in the PIT.  When disabled (the default), every Interest goes through PIT insertion.
+	 */
 	void
-	setCsFromNdnSim(ns3::Ptr<ns3::ndn::ContentStore> cs)
+	setCacheHitFastPathEnabled(bool isEnabled)
 	{
-		m_csFromNdnSim = cs;
+		m_isCacheHitFastPathEnabled = isEnabled;
+	}
+
+	bool
+	isCacheHitFastPathEnabled() const
+	{
+		return m_isCacheHitFastPathEnabled;
 	}
 
 public:
@@ -207,6 +320,11 @@ public:
 	signal::Signal<Forwarder, pit::Entry> beforeExpirePendingInterest;
 
 	PUBLIC_WITH_TESTS_ELSE_PRIVATE: // pipelines
+	/** \brief run the incoming Interest pipeline for every queued Interest
+	 */
+	void
+	processInterestBatch();
+
 	/** \brief incoming Interest pipeline
 	 */
 	VIRTUAL_WITH_TESTS void
@@ -228,6 +346,12 @@ public:
 	onContentStoreHit(const Face& inFace, const shared_ptr<pit::Entry>& pitEntry,
 			const Interest& interest, const Data& data);
 
+	/** \brief Content Store hit pipeline for an Interest without PIT entry
+	 *  \sa setCacheHitFastPathEnabled
+	 */
+	VIRTUAL_WITH_TESTS void
+	onContentStoreHitWithoutPit(const Face& inFace, const Interest& interest, const Data& data);
+
 	/** \brief outgoing Interest pipeline
 	 */
 	VIRTUAL_WITH_TESTS void
@@ -295,6 +419,18 @@ public:
 	insertDeadNonceList(pit::Entry& pitEntry, bool isSatisfied,
 			time::milliseconds dataFreshnessPeriod, Face* upstream);
 
+	/** \brief select the instance of the head function of \p function that the Interest
+	 *         in \p pitEntry is sent to, and count the call on it
+	 */
+	fib::Entry*
+	selectFunctionInstance(const Name& function, const shared_ptr<pit::Entry>& pitEntry);
+
+	/** \brief send a copy of \p interest to the instance recorded for probing, if any
+	 */
+	void
+	sendInstanceProbe(const Face& inFace, const Interest& interest,
+			const fib::Entry& selected, const shared_ptr<pit::Entry>& pitEntry);
+
 	/** \brief call trigger (method) on the effective strategy of pitEntry
 	 */
 #ifdef WITH_TESTS
@@ -316,6 +452,7 @@ private:
 
 	FaceTable m_faceTable;
 	unique_ptr<fw::UnsolicitedDataPolicy> m_unsolicitedDataPolicy;
+	unique_ptr<fw::CsAdmissionPolicy> m_csAdmissionPolicy;
 
 	NameTree           m_nameTree;
 	Fib                m_fib;
@@ -327,7 +464,18 @@ private:
 	NetworkRegionTable m_networkRegionTable;
 	shared_ptr<Face>   m_csFace;
 
-	ns3::Ptr<ns3::ndn::ContentStore> m_csFromNdnSim;
+	bool m_isLoopDetectionEnabled;
+	bool m_isMeasuredInstanceSelectionEnabled;
+	fw::sfc::SfcMeasurements m_sfcMeasurements;
+
+	bool m_isInterestBatchingEnabled;
+	/// Interests received at the current simulated time, with the FaceId of their incoming face
+	std::vector<std::pair<FaceId, shared_ptr<const Interest>>> m_interestBatch;
+	scheduler::ScopedEventId m_interestBatchEvent;
+
+	/// either an interface to m_cs or an ndnSIM content store, so the pipelines do not branch
+	ns3::Ptr<ns3::ndn::ContentStore> m_contentStore;
+	bool m_isCacheHitFastPathEnabled;
 	int table[2][6][3]={
 			{{0,0,0},{0,0,0},{0,0,0},{0,0,0},{0,0,0},{0,0,0}},
 			{{0,0,0},{0,0,0},{0,0,0},{0,0,0},{0,0,0},{0,0,0}},
@@ -0,0 +1,297 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sfc-measurements.hpp"
+#include "core/logger.hpp"
+#include "core/random.hpp"
+
+namespace nfd {
+namespace fw {
+namespace sfc {
+
+NFD_LOG_INIT("SfcMeasurements");
+
+const double InstanceInfo::TIMEOUT_RATIO_ALPHA = 0.125;
+const double InstanceInfo::MAX_TIMEOUT_RATIO = 0.9;
+
+InstanceInfo::InstanceInfo()
+  : m_timeoutRatio(0.0)
+  , m_nOutstanding(0)
+  , m_lastMeasured(time::steady_clock::TimePoint::min())
+{
+}
+
+void
+InstanceInfo::recordRtt(RttEstimator::Duration rtt)
+{
+  m_rttStats.addRttMeasurement(rtt);
+  m_timeoutRatio = (1 - TIMEOUT_RATIO_ALPHA) * m_timeoutRatio;
+  m_lastMeasured = time::steady_clock::now();
+}
+
+void
+InstanceInfo::recordTimeout()
+{
+  m_rttStats.recordTimeout();
+  m_timeoutRatio = TIMEOUT_RATIO_ALPHA + (1 - TIMEOUT_RATIO_ALPHA) * m_timeoutRatio;
+  m_lastMeasured = time::steady_clock::now();
+}
+
+asf::RttStats::Rtt
+InstanceInfo::getExpectedServiceTime() const
+{
+  return asf::RttStats::Rtt(m_rttStats.getSrtt().count() /
+                            (1 - std::min(m_timeoutRatio, MAX_TIMEOUT_RATIO)));
+}
+
+FunctionInfo::FunctionInfo()
+  : isProbingDue(false)
+  , isFirstProbeScheduled(false)
+{
+}
+
+const time::nanoseconds SfcMeasurements::MEASUREMENTS_LIFETIME = time::seconds(300);
+const time::nanoseconds SfcMeasurements::PROBING_INTERVAL = time::seconds(1);
+
+SfcMeasurements::SfcMeasurements(Fib& fib, Measurements& measurements)
+  : m_fib(fib)
+  , m_measurements(measurements)
+{
+}
+
+std::vector<fib::Entry*>
+SfcMeasurements::getInstances(const Name& function) const
+{
+  // instances are named by appending a, b, c... to the function name, see Fib::selectFunction
+  std::vector<fib::Entry*> instances;
+  std::string functionUri = function.toUri();
+  for (char indicator = 'a'; indicator <= 'z'; ++indicator) {
+    fib::Entry* entry = m_fib.findExactMatch(Name(functionUri + indicator));
+    if (entry == nullptr) {
+      break;
+    }
+    instances.push_back(entry);
+  }
+  return instances;
+}
+
+/** \return whether instance \p a is preferred over instance \p b
+ */
+static bool
+isPreferred(const InstanceInfo& a, const InstanceInfo& b)
+{
+  if (a.isTimeout() != b.isTimeout()) {
+    return !a.isTimeout();
+  }
+  if (a.getExpectedServiceTime() != b.getExpectedServiceTime()) {
+    return a.getExpectedServiceTime() < b.getExpectedServiceTime();
+  }
+  return a.getOutstanding() < b.getOutstanding();
+}
+
+fib::Entry*
+SfcMeasurements::selectInstance(const Name& function, pit::Entry& pitEntry)
+{
+  // calls sent for this PIT entry are tracked from now on
+  PitInfo* pi = pitEntry.insertStrategyInfo<PitInfo>().first;
+  std::vector<fib::Entry*> instances = this->getInstances(function);
+
+  fib::Entry* selected = nullptr;
+  InstanceInfo* selectedInfo = nullptr;
+  for (fib::Entry* instance : instances) {
+    InstanceInfo* info = this->getInstanceInfo(instance->getPrefix());
+    if (info == nullptr || !info->hasSrttMeasurement()) {
+      continue;
+    }
+    if (selectedInfo == nullptr || isPreferred(*info, *selectedInfo)) {
+      selected = instance;
+      selectedInfo = info;
+    }
+  }
+
+  FunctionInfo& fi = this->getOrCreateFunctionInfo(function);
+  if (!fi.isFirstProbeScheduled) {
+    // spread the first probes of different functions and nodes over one interval
+    std::uniform_int_distribution<time::nanoseconds::rep> dist(0, PROBING_INTERVAL.count());
+    this->scheduleProbe(fi, time::nanoseconds(dist(getGlobalRng())));
+    fi.isFirstProbeScheduled = true;
+  }
+  if (!fi.isProbingDue || instances.size() < 2) {
+    return selected;
+  }
+
+  // probe an unmeasured instance first, otherwise the one measured least recently
+  fib::Entry* probe = nullptr;
+  time::steady_clock::TimePoint oldest = time::steady_clock::TimePoint::max();
+  for (fib::Entry* instance : instances) {
+    if (instance == selected) {
+      continue;
+    }
+    InstanceInfo* info = this->getInstanceInfo(instance->getPrefix());
+    time::steady_clock::TimePoint lastMeasured = info == nullptr ?
+                                                 time::steady_clock::TimePoint::min() :
+                                                 info->getLastMeasured();
+    if (probe == nullptr || lastMeasured < oldest) {
+      probe = instance;
+      oldest = lastMeasured;
+    }
+  }
+
+  if (selected == nullptr) {
+    // nothing measured yet: the caller falls back to FIB cost, the probe measures an instance
+    NFD_LOG_DEBUG("selectInstance function=" << function << " unmeasured probe=" << probe->getPrefix());
+  }
+  pi->probeInstance = probe->getPrefix();
+  fi.isProbingDue = false;
+  this->scheduleProbe(fi, PROBING_INTERVAL);
+  return selected;
+}
+
+fib::Entry*
+SfcMeasurements::takeProbeInstance(pit::Entry& pitEntry)
+{
+  PitInfo* pi = pitEntry.getStrategyInfo<PitInfo>();
+  if (pi == nullptr || pi->probeInstance.empty()) {
+    return nullptr;
+  }
+
+  Name probeInstance;
+  std::swap(probeInstance, pi->probeInstance);
+  return m_fib.findExactMatch(probeInstance);
+}
+
+void
+SfcMeasurements::afterSendInterest(pit::Entry& pitEntry, const Face& outFace, const Name& instance)
+{
+  PitInfo* pi = pitEntry.getStrategyInfo<PitInfo>();
+  if (pi == nullptr) {
+    // the instance was not selected on this node
+    return;
+  }
+
+  auto it = pi->pendingInstances.find(outFace.getId());
+  if (it != pi->pendingInstances.end()) {
+    if (it->second == instance) {
+      // retransmission toward the same instance is not another outstanding call
+      return;
+    }
+    InstanceInfo* previous = this->getInstanceInfo(it->second);
+    if (previous != nullptr) {
+      previous->decreaseOutstanding();
+    }
+  }
+
+  pi->pendingInstances[outFace.getId()] = instance;
+  this->getOrCreateInstanceInfo(instance).increaseOutstanding();
+}
+
+void
+SfcMeasurements::beforeSatisfyInterest(pit::Entry& pitEntry, const Face& inFace)
+{
+  PitInfo* pi = pitEntry.getStrategyInfo<PitInfo>();
+  if (pi == nullptr) {
+    return;
+  }
+  auto it = pi->pendingInstances.find(inFace.getId());
+  if (it == pi->pendingInstances.end()) {
+    return;
+  }
+
+  InstanceInfo& info = this->getOrCreateInstanceInfo(it->second);
+  info.decreaseOutstanding();
+  pit::OutRecordCollection::iterator outRecord = pitEntry.getOutRecord(inFace);
+  if (outRecord != pitEntry.out_end()) {
+    time::steady_clock::Duration steadyRtt = time::steady_clock::now() - outRecord->getLastRenewed();
+    RttEstimator::Duration rtt = time::duration_cast<RttEstimator::Duration>(steadyRtt);
+    info.recordRtt(rtt);
+    NFD_LOG_DEBUG("instance=" << it->second << " rtt=" << rtt << " srtt=" << info.getSrtt());
+  }
+  pi->pendingInstances.erase(it);
+}
+
+void
+SfcMeasurements::beforeFinalize(pit::Entry& pitEntry, bool isSatisfied)
+{
+  PitInfo* pi = pitEntry.getStrategyInfo<PitInfo>();
+  if (pi == nullptr) {
+    return;
+  }
+
+  for (const auto& pending : pi->pendingInstances) {
+    InstanceInfo* info = this->getInstanceInfo(pending.second);
+    if (info == nullptr) {
+      continue;
+    }
+    info->decreaseOutstanding();
+    if (!isSatisfied) {
+      info->recordTimeout();
+      NFD_LOG_DEBUG("instance=" << pending.second << " timeout ratio=" << info->getTimeoutRatio());
+    }
+  }
+  pi->pendingInstances.clear();
+}
+
+InstanceInfo*
+SfcMeasurements::getInstanceInfo(const Name& instance) const
+{
+  measurements::Entry* me = m_measurements.findExactMatch(instance);
+  if (me == nullptr) {
+    return nullptr;
+  }
+  return me->getStrategyInfo<InstanceInfo>();
+}
+
+InstanceInfo&
+SfcMeasurements::getOrCreateInstanceInfo(const Name& instance)
+{
+  measurements::Entry& me = m_measurements.get(instance);
+  this->extendLifetime(me);
+  return *me.insertStrategyInfo<InstanceInfo>().first;
+}
+
+FunctionInfo&
+SfcMeasurements::getOrCreateFunctionInfo(const Name& function)
+{
+  measurements::Entry& me = m_measurements.get(function);
+  this->extendLifetime(me);
+  return *me.insertStrategyInfo<FunctionInfo>().first;
+}
+
+void
+SfcMeasurements::scheduleProbe(FunctionInfo& info, time::nanoseconds delay)
+{
+  // the event is cancelled if FunctionInfo is deleted together with its Measurements entry
+  info.probeEvent = scheduler::schedule(delay, [&info] { info.isProbingDue = true; });
+}
+
+void
+SfcMeasurements::extendLifetime(measurements::Entry& me)
+{
+  m_measurements.extendLifetime(me, MEASUREMENTS_LIFETIME);
+}
+
+} // namespace sfc
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,256 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_SFC_MEASUREMENTS_HPP
+#define NFD_DAEMON_FW_SFC_MEASUREMENTS_HPP
+
+#include "fw/asf-measurements.hpp"
+#include "table/fib.hpp"
+#include "table/measurements.hpp"
+#include "table/pit-entry.hpp"
+#include "core/scheduler.hpp"
+
+namespace nfd {
+namespace fw {
+namespace sfc {
+
+/** \brief measurements of one function instance, stored under the instance prefix
+ *
+ *  The round-trip time is measured from the node that selected the instance,
+ *  so it includes the execution time of the function and of the rest of the chain.
+ */
+class InstanceInfo : public StrategyInfo
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 1041;
+  }
+
+  InstanceInfo();
+
+  void
+  recordRtt(RttEstimator::Duration rtt);
+
+  void
+  recordTimeout();
+
+  bool
+  hasSrttMeasurement() const
+  {
+    return m_rttStats.getSrtt() != asf::RttStats::RTT_NO_MEASUREMENT;
+  }
+
+  /** \return whether the last call to this instance timed out
+   */
+  bool
+  isTimeout() const
+  {
+    return m_rttStats.getRtt() == asf::RttStats::RTT_TIMEOUT;
+  }
+
+  asf::RttStats::Rtt
+  getSrtt() const
+  {
+    return m_rttStats.getSrtt();
+  }
+
+  /** \return exponentially weighted fraction of calls that timed out
+   */
+  double
+  getTimeoutRatio() const
+  {
+    return m_timeoutRatio;
+  }
+
+  /** \return expected end-to-end service time of a call, SRTT divided by the success ratio
+   *
+   *  A call that times out has to be retransmitted, so 1 / (1 - timeout ratio) calls
+   *  are expected to be sent for each call that succeeds.
+   */
+  asf::RttStats::Rtt
+  getExpectedServiceTime() const;
+
+  size_t
+  getOutstanding() const
+  {
+    return m_nOutstanding;
+  }
+
+  void
+  increaseOutstanding()
+  {
+    ++m_nOutstanding;
+  }
+
+  void
+  decreaseOutstanding()
+  {
+    if (m_nOutstanding > 0) {
+      --m_nOutstanding;
+    }
+  }
+
+  /** \return when the last RTT or timeout was recorded
+   */
+  time::steady_clock::TimePoint
+  getLastMeasured() const
+  {
+    return m_lastMeasured;
+  }
+
+public:
+  static const double TIMEOUT_RATIO_ALPHA;
+  static const double MAX_TIMEOUT_RATIO;
+
+private:
+  asf::RttStats m_rttStats;
+  double m_timeoutRatio;
+  size_t m_nOutstanding;
+  time::steady_clock::TimePoint m_lastMeasured;
+};
+
+/** \brief probing state of a function, stored under the function prefix
+ */
+class FunctionInfo : public StrategyInfo
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 1042;
+  }
+
+  FunctionInfo();
+
+public:
+  bool isProbingDue;
+  bool isFirstProbeScheduled;
+  scheduler::ScopedEventId probeEvent;
+};
+
+/** \brief instances that a PIT entry is waiting for, stored on the PIT entry
+ */
+class PitInfo : public StrategyInfo
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 1043;
+  }
+
+public:
+  /** \brief instance reached through each upstream face that has not returned Data yet
+   */
+  std::unordered_map<FaceId, Name> pendingInstances;
+
+  /** \brief instance to probe once the Interest has been forwarded, empty if none
+   */
+  Name probeInstance;
+};
+
+/** \brief selects function instances by measured service time
+ *
+ *  Each call forwarded toward an instance is tracked on its PIT entry. The time until
+ *  Data comes back is recorded as the instance RTT, and an unsatisfied PIT entry is recorded
+ *  as a timeout. selectInstance returns the instance with the lowest expected service time,
+ *  and schedules a probe toward another instance every PROBING_INTERVAL, so that instances
+ *  which are not preferred keep being measured and a slowdown of the preferred one is followed.
+ */
+class SfcMeasurements : noncopyable
+{
+public:
+  SfcMeasurements(Fib& fib, Measurements& measurements);
+
+  /** \return FIB entries of the instances of \p function, e.g. /F1a, /F1b, /F1c for /F1
+   */
+  std::vector<fib::Entry*>
+  getInstances(const Name& function) const;
+
+  /** \brief select the instance of \p function with the lowest expected service time
+   *
+   *  Instances whose last call timed out rank behind the others; ties are broken by
+   *  the number of outstanding calls. Calls later sent for \p pitEntry are tracked,
+   *  and if probing is due for \p function, an instance to probe is recorded on it.
+   *  \return the selected instance, or nullptr if no instance has been measured yet
+   */
+  fib::Entry*
+  selectInstance(const Name& function, pit::Entry& pitEntry);
+
+  /** \return the instance to probe recorded by selectInstance, and clears it
+   */
+  fib::Entry*
+  takeProbeInstance(pit::Entry& pitEntry);
+
+  /** \brief record that an Interest toward \p instance was sent to \p outFace
+   *
+   *  This has no effect unless the instance was selected for \p pitEntry by selectInstance.
+   */
+  void
+  afterSendInterest(pit::Entry& pitEntry, const Face& outFace, const Name& instance);
+
+  /** \brief record the RTT of the instance reached through \p inFace
+   *  \pre the out-record of \p inFace has not been deleted yet
+   */
+  void
+  beforeSatisfyInterest(pit::Entry& pitEntry, const Face& inFace);
+
+  /** \brief release outstanding calls of \p pitEntry, recording timeouts if it is unsatisfied
+   */
+  void
+  beforeFinalize(pit::Entry& pitEntry, bool isSatisfied);
+
+  InstanceInfo*
+  getInstanceInfo(const Name& instance) const;
+
+  InstanceInfo&
+  getOrCreateInstanceInfo(const Name& instance);
+
+private:
+  FunctionInfo&
+  getOrCreateFunctionInfo(const Name& function);
+
+  void
+  scheduleProbe(FunctionInfo& info, time::nanoseconds delay);
+
+  void
+  extendLifetime(measurements::Entry& me);
+
+public:
+  static const time::nanoseconds MEASUREMENTS_LIFETIME;
+  static const time::nanoseconds PROBING_INTERVAL;
+
+private:
+  Fib& m_fib;
+  Measurements& m_measurements;
+};
+
+} // namespace sfc
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_SFC_MEASUREMENTS_HPP
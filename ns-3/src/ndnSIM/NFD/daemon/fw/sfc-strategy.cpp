@@ -0,0 +1,309 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sfc-strategy.hpp"
+#include "algorithm.hpp"
+#include "core/logger.hpp"
+
+namespace nfd {
+namespace fw {
+
+NFD_LOG_INIT("SfcStrategy");
+
+const Name SfcStrategy::STRATEGY_NAME("ndn:/localhost/nfd/strategy/sfc/%FD%01");
+NFD_REGISTER_STRATEGY(SfcStrategy);
+
+const uint64_t SfcStrategy::LOAD_COST = 1;
+const time::milliseconds SfcStrategy::RETX_SUPPRESSION_INITIAL(10);
+const time::milliseconds SfcStrategy::RETX_SUPPRESSION_MAX(250);
+
+SfcStrategy::SfcStrategy(Forwarder& forwarder, const Name& name)
+  : Strategy(forwarder, name)
+  , m_retxSuppression(RETX_SUPPRESSION_INITIAL,
+                      RetxSuppressionExponential::DEFAULT_MULTIPLIER,
+                      RETX_SUPPRESSION_MAX)
+  , m_loads(make_shared<LoadTable>())
+  , m_removeLoadConn(this->beforeRemoveFace.connect(bind(&SfcStrategy::removeLoad, this, _1)))
+{
+}
+
+uint64_t
+SfcStrategy::getLoad(const Face& face) const
+{
+  auto it = m_loads->find(face.getId());
+  return it == m_loads->end() ? 0 : it->second;
+}
+
+void
+SfcStrategy::afterReceiveInterest(const Face& inFace, const Interest& interest,
+                                  const shared_ptr<pit::Entry>& pitEntry)
+{
+  const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
+  this->forward(inFace, interest, fibEntry, pitEntry);
+}
+
+void
+SfcStrategy::afterReceiveFunctionInterest(const Face& inFace, const Interest& interest,
+                                          const fib::Entry& fibEntry,
+                                          const shared_ptr<pit::Entry>& pitEntry)
+{
+  PitInfo* pi = pitEntry->insertStrategyInfo<PitInfo>(m_loads).first;
+  pi->instance = fibEntry.getPrefix();
+  this->forward(inFace, interest, fibEntry, pitEntry);
+}
+
+void
+SfcStrategy::forward(const Face& inFace, const Interest& interest,
+                     const fib::Entry& fibEntry, const shared_ptr<pit::Entry>& pitEntry)
+{
+  RetxSuppression::Result suppression = m_retxSuppression.decide(inFace, interest, *pitEntry);
+  if (suppression == RetxSuppression::SUPPRESS) {
+    NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " suppressed");
+    return;
+  }
+
+  if (suppression == RetxSuppression::NEW) {
+    const fib::NextHop* nexthop = this->findBestNextHop(inFace, interest, fibEntry, *pitEntry,
+                                                        false, false);
+    if (nexthop == nullptr) {
+      NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " noNextHop");
+
+      lp::NackHeader nackHeader;
+      nackHeader.setReason(lp::NackReason::NO_ROUTE);
+      this->sendNack(pitEntry, inFace, nackHeader);
+
+      this->rejectPendingInterest(pitEntry);
+      return;
+    }
+
+    this->sendToNextHop(pitEntry, nexthop->getFace(), interest);
+    NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " instance=" << fibEntry.getPrefix()
+                           << " newPitEntry-to=" << nexthop->getFace().getId());
+    return;
+  }
+
+  // prefer an upstream that has not been used or whose out-record has expired,
+  // so that an upstream which did not answer in time is replaced
+  const fib::NextHop* nexthop = this->findBestNextHop(inFace, interest, fibEntry, *pitEntry,
+                                                      true, false);
+  if (nexthop == nullptr) {
+    nexthop = this->findBestNextHop(inFace, interest, fibEntry, *pitEntry, false, false);
+  }
+  if (nexthop == nullptr) {
+    NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " retransmitNoNextHop");
+    return;
+  }
+
+  this->sendToNextHop(pitEntry, nexthop->getFace(), interest);
+  NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " instance=" << fibEntry.getPrefix()
+                         << " retransmit-to=" << nexthop->getFace().getId());
+}
+
+const fib::NextHop*
+SfcStrategy::findBestNextHop(const Face& inFace, const Interest& interest,
+                             const fib::Entry& fibEntry, pit::Entry& pitEntry,
+                             bool wantUnused, bool wantUntried) const
+{
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  const fib::NextHop* best = nullptr;
+  uint64_t bestScore = std::numeric_limits<uint64_t>::max();
+
+  // nexthops are sorted by cost, so a strict comparison lets the lower cost win a tie
+  for (const fib::NextHop& nexthop : fibEntry.getNextHops()) {
+    const Face& outFace = nexthop.getFace();
+    if (&outFace == &inFace || wouldViolateScope(inFace, interest, outFace)) {
+      continue;
+    }
+
+    if (wantUnused || wantUntried) {
+      pit::OutRecordCollection::iterator outRecord = pitEntry.getOutRecord(outFace);
+      if (outRecord != pitEntry.out_end() && (wantUntried || outRecord->getExpiry() > now)) {
+        continue;
+      }
+    }
+
+    uint64_t score = nexthop.getCost() + LOAD_COST * this->getLoad(outFace);
+    if (score < bestScore) {
+      best = &nexthop;
+      bestScore = score;
+    }
+  }
+  return best;
+}
+
+void
+SfcStrategy::sendToNextHop(const shared_ptr<pit::Entry>& pitEntry, Face& outFace,
+                           const Interest& interest)
+{
+  pitEntry->insertStrategyInfo<PitInfo>(m_loads).first->addPending(outFace.getId());
+  this->sendInterest(pitEntry, outFace, interest);
+}
+
+void
+SfcStrategy::beforeSatisfyInterest(const shared_ptr<pit::Entry>& pitEntry,
+                                   const Face& inFace, const Data& data)
+{
+  PitInfo* pi = pitEntry->getStrategyInfo<PitInfo>();
+  if (pi != nullptr) {
+    pi->releaseAll();
+  }
+}
+
+/** \return less severe NackReason between x and y
+ *
+ *  lp::NackReason::NONE is treated as most severe
+ */
+static lp::NackReason
+getLessSevere(lp::NackReason x, lp::NackReason y)
+{
+  if (x == lp::NackReason::NONE) {
+    return y;
+  }
+  if (y == lp::NackReason::NONE) {
+    return x;
+  }
+  return static_cast<lp::NackReason>(std::min(static_cast<int>(x), static_cast<int>(y)));
+}
+
+void
+SfcStrategy::afterReceiveNack(const Face& inFace, const lp::Nack& nack,
+                              const shared_ptr<pit::Entry>& pitEntry)
+{
+  PitInfo* pi = pitEntry->getStrategyInfo<PitInfo>();
+  if (pi != nullptr) {
+    pi->releasePending(inFace.getId());
+  }
+
+  // fall back to the best nexthop that has not been tried for this PIT entry
+  const fib::Entry* fibEntry = nullptr;
+  if (pi != nullptr && !pi->instance.empty()) {
+    fibEntry = this->lookupFunctionFib(pi->instance);
+  }
+  else {
+    fibEntry = &this->lookupFib(*pitEntry);
+  }
+
+  if (fibEntry != nullptr && pitEntry->hasInRecords()) {
+    pit::InRecordCollection::iterator inR = std::max_element(pitEntry->in_begin(), pitEntry->in_end(),
+      [] (const pit::InRecord& a, const pit::InRecord& b) {
+        return a.getLastRenewed() < b.getLastRenewed();
+      });
+    const fib::NextHop* nexthop = this->findBestNextHop(inR->getFace(), inR->getInterest(),
+                                                        *fibEntry, *pitEntry, false, true);
+    if (nexthop != nullptr) {
+      this->sendToNextHop(pitEntry, nexthop->getFace(), inR->getInterest());
+      NFD_LOG_DEBUG(nack.getInterest() << " nack-from=" << inFace.getId() <<
+                    " nack=" << nack.getReason() <<
+                    " fallback-to=" << nexthop->getFace().getId());
+      return;
+    }
+  }
+
+  int nOutRecordsNotNacked = 0;
+  lp::NackReason leastSevereReason = lp::NackReason::NONE;
+  for (const pit::OutRecord& outR : pitEntry->getOutRecords()) {
+    const lp::NackHeader* inNack = outR.getIncomingNack();
+    if (inNack == nullptr) {
+      ++nOutRecordsNotNacked;
+      continue;
+    }
+    leastSevereReason = getLessSevere(leastSevereReason, inNack->getReason());
+  }
+
+  if (nOutRecordsNotNacked > 0) {
+    NFD_LOG_DEBUG(nack.getInterest() << " nack-from=" << inFace.getId() <<
+                  " nack=" << nack.getReason() <<
+                  " waiting=" << nOutRecordsNotNacked);
+    return;
+  }
+
+  lp::NackHeader outNack;
+  outNack.setReason(leastSevereReason);
+  NFD_LOG_DEBUG(nack.getInterest() << " nack-from=" << inFace.getId() <<
+                " nack=" << nack.getReason() <<
+                " nack-to=all out-nack=" << outNack.getReason());
+  this->sendNacks(pitEntry, outNack);
+}
+
+void
+SfcStrategy::removeLoad(const Face& face)
+{
+  m_loads->erase(face.getId());
+}
+
+SfcStrategy::PitInfo::PitInfo(const shared_ptr<LoadTable>& loads)
+  : m_loads(loads)
+{
+}
+
+SfcStrategy::PitInfo::~PitInfo()
+{
+  this->releaseAll();
+}
+
+void
+SfcStrategy::PitInfo::addPending(FaceId face)
+{
+  if (std::find(m_pending.begin(), m_pending.end(), face) != m_pending.end()) {
+    return;
+  }
+
+  shared_ptr<LoadTable> loads = m_loads.lock();
+  if (loads == nullptr) {
+    return;
+  }
+  ++(*loads)[face];
+  m_pending.push_back(face);
+}
+
+void
+SfcStrategy::PitInfo::releasePending(FaceId face)
+{
+  auto it = std::find(m_pending.begin(), m_pending.end(), face);
+  if (it == m_pending.end()) {
+    return;
+  }
+  m_pending.erase(it);
+
+  shared_ptr<LoadTable> loads = m_loads.lock();
+  if (loads == nullptr) {
+    return;
+  }
+  auto load = loads->find(face);
+  if (load != loads->end() && load->second > 0) {
+    --load->second;
+  }
+}
+
+void
+SfcStrategy::PitInfo::releaseAll()
+{
+  while (!m_pending.empty()) {
+    this->releasePending(m_pending.back());
+  }
+}
+
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,173 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_SFC_STRATEGY_HPP
+#define NFD_DAEMON_FW_SFC_STRATEGY_HPP
+
+#include "strategy.hpp"
+#include "retx-suppression-exponential.hpp"
+#include <unordered_map>
+
+namespace nfd {
+namespace fw {
+
+/** \brief Service Function Chaining strategy version 1
+ *
+ *  This strategy forwards an Interest to a single nexthop.
+ *  For an Interest whose function field is non-empty, the nexthops are taken from the
+ *  FIB entry of the function instance chosen by the forwarder; otherwise they are taken
+ *  from the FIB entry of the Interest name.
+ *
+ *  Each eligible nexthop is scored by its FIB cost plus the number of Interests this
+ *  strategy has forwarded to that face and that are still pending (LOAD_COST each).
+ *  The nexthop with the lowest score is used; ties go to the lower FIB cost.
+ *
+ *  When a Nack comes back, the Interest is forwarded to the best nexthop that has
+ *  not been tried yet. Nacks are returned downstream only after all tried upstreams
+ *  have Nacked and no untried nexthop remains.
+ *
+ *  Consumer retransmissions are subject to exponential retransmission suppression.
+ *  An accepted retransmission goes to the best nexthop without an unexpired out-record,
+ *  so that an upstream that timed out is replaced by another one;
+ *  if every nexthop has been used, the best-scored nexthop is retried.
+ */
+class SfcStrategy : public Strategy
+{
+public:
+  explicit
+  SfcStrategy(Forwarder& forwarder, const Name& name = STRATEGY_NAME);
+
+public: // triggers
+  virtual void
+  afterReceiveInterest(const Face& inFace, const Interest& interest,
+                       const shared_ptr<pit::Entry>& pitEntry) override;
+
+  virtual void
+  afterReceiveFunctionInterest(const Face& inFace, const Interest& interest,
+                               const fib::Entry& fibEntry,
+                               const shared_ptr<pit::Entry>& pitEntry) override;
+
+  virtual void
+  beforeSatisfyInterest(const shared_ptr<pit::Entry>& pitEntry,
+                        const Face& inFace, const Data& data) override;
+
+  virtual void
+  afterReceiveNack(const Face& inFace, const lp::Nack& nack,
+                   const shared_ptr<pit::Entry>& pitEntry) override;
+
+public:
+  /** \brief number of Interests pending on each upstream face
+   */
+  typedef std::unordered_map<FaceId, uint64_t> LoadTable;
+
+  /** \return number of Interests forwarded to \p face by this strategy that are still pending
+   */
+  uint64_t
+  getLoad(const Face& face) const;
+
+private: // StrategyInfo
+  /** \brief StrategyInfo on PIT entry
+   *
+   *  Records the upstreams counted in the load table for this PIT entry,
+   *  and releases them when the PIT entry is satisfied, Nacked, or deleted.
+   */
+  class PitInfo : public StrategyInfo
+  {
+  public:
+    static constexpr int
+    getTypeId()
+    {
+      return 1040;
+    }
+
+    explicit
+    PitInfo(const shared_ptr<LoadTable>& loads);
+
+    ~PitInfo();
+
+    void
+    addPending(FaceId face);
+
+    void
+    releasePending(FaceId face);
+
+    void
+    releaseAll();
+
+  public:
+    /** \brief prefix of the function instance FIB entry, empty if the Interest has no function
+     */
+    Name instance;
+
+  private:
+    weak_ptr<LoadTable> m_loads;
+    std::vector<FaceId> m_pending;
+  };
+
+private: // forwarding procedures
+  void
+  forward(const Face& inFace, const Interest& interest,
+          const fib::Entry& fibEntry, const shared_ptr<pit::Entry>& pitEntry);
+
+  /** \brief find the eligible nexthop with the lowest cost plus load
+   *  \param wantUnused if true, the nexthop must not have an unexpired out-record
+   *  \param wantUntried if true, the nexthop must not have any out-record
+   */
+  const fib::NextHop*
+  findBestNextHop(const Face& inFace, const Interest& interest,
+                  const fib::Entry& fibEntry, pit::Entry& pitEntry,
+                  bool wantUnused, bool wantUntried) const;
+
+  void
+  sendToNextHop(const shared_ptr<pit::Entry>& pitEntry, Face& outFace,
+                const Interest& interest);
+
+  void
+  removeLoad(const Face& face);
+
+public:
+  static const Name STRATEGY_NAME;
+
+  /** \brief score added to a nexthop for each Interest pending on it
+   *
+   *  With ndnSIM global routing the FIB cost is the sum of link metrics,
+   *  so one pending Interest weighs as much as one extra unit-metric hop.
+   */
+  static const uint64_t LOAD_COST;
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  static const time::milliseconds RETX_SUPPRESSION_INITIAL;
+  static const time::milliseconds RETX_SUPPRESSION_MAX;
+  RetxSuppressionExponential m_retxSuppression;
+
+private:
+  shared_ptr<LoadTable> m_loads;
+  signal::ScopedConnection m_removeLoadConn;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_SFC_STRATEGY_HPP
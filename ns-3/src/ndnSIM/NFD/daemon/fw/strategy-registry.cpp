@@ -59,5 +59,38 @@ installStrategies(Forwarder& forwarder)
   }
 }
 
+Name
+findRegisteredStrategy(const Name& strategyName, bool isExact)
+{
+  const auto& factories = getStrategyFactories();
+  if (isExact) {
+    return factories.count(strategyName) > 0 ? strategyName : Name();
+  }
+
+  Name candidate;
+  for (auto it = factories.lower_bound(strategyName);
+       it != factories.end() && strategyName.isPrefixOf(it->first); ++it) {
+    switch (it->first.size() - strategyName.size()) {
+    case 0: // exact match
+      return it->first;
+    case 1: // unversioned strategyName matches versioned strategy
+      candidate = it->first;
+      break;
+    }
+  }
+  return candidate;
+}
+
+unique_ptr<Strategy>
+makeStrategy(const Name& strategyName, Forwarder& forwarder)
+{
+  const auto& factories = getStrategyFactories();
+  auto it = factories.find(strategyName);
+  if (it == factories.end()) {
+    return nullptr;
+  }
+  return it->second(forwarder);
+}
+
 } // namespace fw
 } // namespace nfd
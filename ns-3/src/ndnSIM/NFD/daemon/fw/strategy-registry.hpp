@@ -39,9 +39,28 @@ class Strategy;
 unique_ptr<Strategy>
 makeDefaultStrategy(Forwarder& forwarder);
 
+/** \brief install every registered strategy into \p forwarder
+ *  \note Forwarder itself instantiates registered strategies on demand,
+ *        see StrategyChoice::enableOnDemandInstallation
+ */
 void
 installStrategies(Forwarder& forwarder);
 
+/** \brief find the registered strategy that \p strategyName refers to
+ *  \param strategyName a versioned or unversioned strategyName
+ *  \param isExact true to require exact match, false to permit unversioned strategyName
+ *  \return name of the registered strategy, which is the latest version if \p strategyName
+ *          is unversioned; or an empty Name if no registered strategy matches
+ */
+Name
+findRegisteredStrategy(const Name& strategyName, bool isExact = false);
+
+/** \brief instantiate the registered strategy named exactly \p strategyName
+ *  \return the new strategy instance, or nullptr if \p strategyName is not registered
+ */
+unique_ptr<Strategy>
+makeStrategy(const Name& strategyName, Forwarder& forwarder);
+
 
 typedef std::function<unique_ptr<Strategy>(Forwarder&)> StrategyCreateFunc;
 
@@ -67,6 +67,19 @@ Strategy::afterReceiveNack(const Face& inFace, const lp::Nack& nack,
                 " pitEntry=" << pitEntry->getName());
 }
 
+void
+Strategy::afterReceiveFunctionInterest(const Face& inFace, const Interest& interest,
+                                       const fib::Entry& fibEntry,
+                                       const shared_ptr<pit::Entry>& pitEntry)
+{
+  NFD_LOG_DEBUG("afterReceiveFunctionInterest inFace=" << inFace.getId() <<
+                " pitEntry=" << pitEntry->getName() << " instance=" << fibEntry.getPrefix());
+
+  for (const fib::NextHop& nexthop : fibEntry.getNextHops()) {
+    this->sendInterest(pitEntry, nexthop.getFace(), interest);
+  }
+}
+
 void
 Strategy::sendInterest(const shared_ptr<pit::Entry>& pitEntry, Face& outFace,
                        bool wantNewNonce)
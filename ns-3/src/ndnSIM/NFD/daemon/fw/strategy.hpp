@@ -127,6 +127,23 @@ public: // triggers
   afterReceiveNack(const Face& inFace, const lp::Nack& nack,
                    const shared_ptr<pit::Entry>& pitEntry);
 
+  /** \brief trigger after an Interest with a non-empty function field is received
+   *
+   *  The Interest satisfies the same conditions as in \p afterReceiveInterest.
+   *  The forwarder has already rewritten its function fields for this hop,
+   *  and \p fibEntry is the route toward the selected function instance
+   *  rather than the FIB entry of the Interest name.
+   *
+   *  In this base class this method forwards the Interest to every nexthop of \p fibEntry.
+   *
+   *  \warning The strategy must not retain shared_ptr<pit::Entry>, otherwise undefined behavior
+   *           may occur. However, the strategy is allowed to store weak_ptr<pit::Entry>.
+   */
+  virtual void
+  afterReceiveFunctionInterest(const Face& inFace, const Interest& interest,
+                               const fib::Entry& fibEntry,
+                               const shared_ptr<pit::Entry>& pitEntry);
+
 protected: // actions
   /** \brief send Interest to outFace
    *  \param pitEntry PIT entry
@@ -195,6 +212,15 @@ protected: // accessors
   const fib::Entry&
   lookupFib(const pit::Entry& pitEntry) const;
 
+  /** \brief performs a FIB exact match lookup for a function instance prefix
+   *  \return the FIB entry, or nullptr if the instance is no longer routed
+   */
+  const fib::Entry*
+  lookupFunctionFib(const Name& instance) const
+  {
+    return m_forwarder.getFib().findExactMatch(instance);
+  }
+
   MeasurementsAccessor&
   getMeasurements()
   {
@@ -51,6 +51,7 @@ TablesConfigSection::ensureConfigured()
 
   m_forwarder.getCs().setLimit(DEFAULT_CS_MAX_PACKETS);
   m_forwarder.setUnsolicitedDataPolicy(make_unique<fw::DefaultUnsolicitedDataPolicy>());
+  m_forwarder.setCsAdmissionPolicy(make_unique<fw::DefaultCsAdmissionPolicy>());
 
   m_isConfigured = true;
 }
@@ -80,6 +81,20 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun)
     unsolicitedDataPolicy = make_unique<fw::DefaultUnsolicitedDataPolicy>();
   }
 
+  unique_ptr<fw::CsAdmissionPolicy> csAdmissionPolicy;
+  OptionalNode csAdmissionNode = section.get_child_optional("cs_admission");
+  if (csAdmissionNode) {
+    std::string policyKey = csAdmissionNode->get<std::string>("policy", "admit-all");
+    csAdmissionPolicy = fw::CsAdmissionPolicy::create(policyKey, *csAdmissionNode);
+    if (csAdmissionPolicy == nullptr) {
+      BOOST_THROW_EXCEPTION(ConfigFile::Error(
+        "Unknown cs_admission policy \"" + policyKey + "\" in \"tables\" section"));
+    }
+  }
+  else {
+    csAdmissionPolicy = make_unique<fw::DefaultCsAdmissionPolicy>();
+  }
+
   OptionalNode strategyChoiceSection = section.get_child_optional("strategy_choice");
   if (strategyChoiceSection) {
     processStrategyChoiceSection(*strategyChoiceSection, isDryRun);
@@ -98,6 +113,8 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun)
 
   m_forwarder.setUnsolicitedDataPolicy(std::move(unsolicitedDataPolicy));
 
+  m_forwarder.setCsAdmissionPolicy(std::move(csAdmissionPolicy));
+
   m_isConfigured = true;
 }
 
@@ -34,11 +34,11 @@ EntryImpl::EntryImpl(const Name& name)
   BOOST_ASSERT(this->isQuery());
 }
 
-EntryImpl::EntryImpl(shared_ptr<const Data> data, bool isUnsolicited, int latency, long long currenttime)
+EntryImpl::EntryImpl(shared_ptr<const Data> data, bool isUnsolicited, time::nanoseconds retrievalCost)
 {
   this->setData(data, isUnsolicited);
-  this->setLatency(latency);
-  this->setCurrentTime(currenttime);
+  this->setRetrievalCost(retrievalCost);
+  this->updateCurrentTime();
   BOOST_ASSERT(!this->isQuery());
 }
 
@@ -50,7 +50,7 @@ public:
 
   /** \brief construct Entry for storage
    */
-  EntryImpl(shared_ptr<const Data> data, bool isUnsolicited, int latency, long long currenttime);
+  EntryImpl(shared_ptr<const Data> data, bool isUnsolicited, time::nanoseconds retrievalCost);
 
   /** \return true if entry can become stale, false if entry is never stale
    */
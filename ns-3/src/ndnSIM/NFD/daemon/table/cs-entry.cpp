@@ -25,9 +25,22 @@
 
 #include "cs-entry.hpp"
 
+#include <limits>
+
 namespace nfd {
 namespace cs {
 
+uint32_t
+encodeRetrievalCost(time::nanoseconds retrievalCost)
+{
+  time::microseconds::rep us = time::duration_cast<time::microseconds>(retrievalCost).count();
+  if (us <= 0) {
+    return 0;
+  }
+  return static_cast<uint32_t>(std::min<time::microseconds::rep>(us,
+                               std::numeric_limits<uint32_t>::max()));
+}
+
 void
 Entry::setData(shared_ptr<const Data> data, bool isUnsolicited)
 {
@@ -56,6 +69,12 @@ Entry::updateStaleTime()
   }
 }
 
+void
+Entry::setRetrievalCost(time::nanoseconds retrievalCost)
+{
+  m_retrievalCost = encodeRetrievalCost(retrievalCost);
+}
+
 void
 Entry::updateCurrentTime()
 {
@@ -86,7 +105,7 @@ Entry::reset()
   m_data.reset();
   m_isUnsolicited = false;
   m_staleTime = time::steady_clock::TimePoint();
-  m_latency = 0;
+  m_retrievalCost = 0;
   m_currenttime = 0;
 }
 
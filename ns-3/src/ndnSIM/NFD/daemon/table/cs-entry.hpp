@@ -31,6 +31,23 @@
 namespace nfd {
 namespace cs {
 
+/** \brief encode the cost of retrieving a Data as stored in a CS entry
+ *
+ *  The cost is kept in microseconds, and saturates at about 71 minutes.
+ *  Negative costs are encoded as zero.
+ *  This encoding is shared with ndnSIM's content stores.
+ */
+uint32_t
+encodeRetrievalCost(time::nanoseconds retrievalCost);
+
+/** \return retrieval cost encoded by encodeRetrievalCost
+ */
+inline time::nanoseconds
+decodeRetrievalCost(uint32_t encodedCost)
+{
+  return time::microseconds(encodedCost);
+}
+
 /** \brief represents a base class for CS entry
  */
 class Entry
@@ -96,22 +113,21 @@ public: // exposed through ContentStore enumeration
     return m_staleTime;
   }
 
-  //masuda
-
-  const int&
-  getLatency() const
+  /** \return cost of retrieving the Data again, i.e. its round-trip time when it was inserted
+   *  \sa encodeRetrievalCost
+   */
+  time::nanoseconds
+  getRetrievalCost() const
   {
     BOOST_ASSERT(this->hasData());
-    return m_latency;
-  }
-
-  void 
-  setLatency(const int& latency)
-  {
-    m_latency = latency;
+    return decodeRetrievalCost(m_retrievalCost);
   }
 
+  void
+  setRetrievalCost(time::nanoseconds retrievalCost);
 
+  /** \return time of the last use, in nanoseconds since the clock epoch
+   */
   const long long&
   getCurrentTime() const
   {
@@ -119,12 +135,6 @@ public: // exposed through ContentStore enumeration
     return m_currenttime;
   }
 
-  void
-  setCurrentTime(const long long& currenttime)
-  {
-    m_currenttime = currenttime;
-  }
-
  // const int&
  // getMetricsTime() const;
   
@@ -182,7 +192,7 @@ private:
   shared_ptr<const Data> m_data;
   bool m_isUnsolicited;
   time::steady_clock::TimePoint m_staleTime; 
-  int m_latency; //masuda
+  uint32_t m_retrievalCost; ///< retrieval cost in microseconds
   long long m_currenttime;
 };
 
@@ -81,7 +81,7 @@ Cs::setPolicy(unique_ptr<Policy> policy)
 
 
 void
-Cs::insert(const Data& data, bool isUnsolicited, int latency, long long currenttime)
+Cs::insert(const Data& data, bool isUnsolicited, time::nanoseconds retrievalCost)
 {
   NFD_LOG_DEBUG("insert " << data.getName());
 
@@ -102,7 +102,7 @@ Cs::insert(const Data& data, bool isUnsolicited, int latency, long long currentt
   bool isNewEntry = false;
   iterator it;
   // use .insert because gcc46 does not support .emplace
-  std::tie(it, isNewEntry) = m_table.insert(EntryImpl(data.shared_from_this(), isUnsolicited, latency, currenttime));
+  std::tie(it, isNewEntry) = m_table.insert(EntryImpl(data.shared_from_this(), isUnsolicited, retrievalCost));
   EntryImpl& entry = const_cast<EntryImpl&>(*it);
 
 
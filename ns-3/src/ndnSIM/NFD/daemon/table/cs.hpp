@@ -69,9 +69,11 @@ public:
   Cs(size_t nMaxPackets = 10, unique_ptr<Policy> policy = makeDefaultPolicy());
 
   /** \brief inserts a Data packet
+   *  \param retrievalCost simulated time from sending the Interest upstream until the Data arrived
    */
   void
-  insert(const Data& data, bool isUnsolicited = false, int latency = 0, long long currenttime = 0);
+  insert(const Data& data, bool isUnsolicited = false,
+         time::nanoseconds retrievalCost = time::nanoseconds::zero());
 
 
 
@@ -33,73 +33,99 @@ namespace nfd {
 
 const time::nanoseconds DeadNonceList::DEFAULT_LIFETIME = time::seconds(6);
 const time::nanoseconds DeadNonceList::MIN_LIFETIME = time::milliseconds(1);
-const size_t DeadNonceList::INITIAL_CAPACITY = (1 << 7);
-const size_t DeadNonceList::MIN_CAPACITY = (1 << 3);
-const size_t DeadNonceList::MAX_CAPACITY = (1 << 24);
-const DeadNonceList::Entry DeadNonceList::MARK = 0;
+const size_t DeadNonceList::DEFAULT_CAPACITY = (1 << 14);
+const size_t DeadNonceList::BUCKET_SIZE = 4;
+const size_t DeadNonceList::MAX_KICKS = 500;
 const size_t DeadNonceList::EXPECTED_MARK_COUNT = 5;
-const double DeadNonceList::CAPACITY_UP = 1.2;
-const double DeadNonceList::CAPACITY_DOWN = 0.9;
-const size_t DeadNonceList::EVICT_LIMIT = (1 << 6);
 
-DeadNonceList::DeadNonceList(const time::nanoseconds& lifetime)
+/** \brief minimum capacity, so that the filter has at least two buckets
+ */
+static const size_t MIN_CAPACITY = (1 << 3);
+
+static size_t
+roundUpToPowerOfTwo(size_t n)
+{
+  size_t p = 1;
+  while (p < n) {
+    p <<= 1;
+  }
+  return p;
+}
+
+DeadNonceList::DeadNonceList(const time::nanoseconds& lifetime, size_t capacity)
   : m_lifetime(lifetime)
-  , m_queue(m_index.get<0>())
-  , m_ht(m_index.get<1>())
-  , m_capacity(INITIAL_CAPACITY)
+  , m_capacity(roundUpToPowerOfTwo(std::max(capacity, MIN_CAPACITY)))
+  , m_nAdded(0)
+  , m_nEvicted(0)
+  , m_bucketMask(0)
+  , m_hasVictim(false)
+  , m_victimBucket(0)
+  , m_victim(0)
+  , m_marks(EXPECTED_MARK_COUNT, 0)
+  , m_markPos(0)
   , m_markInterval(m_lifetime / EXPECTED_MARK_COUNT)
-  , m_adjustCapacityInterval(m_lifetime)
 {
   if (m_lifetime < MIN_LIFETIME) {
     BOOST_THROW_EXCEPTION(std::invalid_argument("lifetime is less than MIN_LIFETIME"));
   }
-
-  for (size_t i = 0; i < EXPECTED_MARK_COUNT; ++i) {
-    m_queue.push_back(MARK);
-  }
-
-  m_markEvent = scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
-  m_adjustCapacityEvent = scheduler::schedule(m_adjustCapacityInterval,
-                                              bind(&DeadNonceList::adjustCapacity, this));
 }
 
 DeadNonceList::~DeadNonceList()
 {
   scheduler::cancel(m_markEvent);
-  scheduler::cancel(m_adjustCapacityEvent);
 
   BOOST_ASSERT_MSG(DEFAULT_LIFETIME >= MIN_LIFETIME, "DEFAULT_LIFETIME is too small");
-  static_assert(INITIAL_CAPACITY >= MIN_CAPACITY, "INITIAL_CAPACITY is too small");
-  static_assert(INITIAL_CAPACITY <= MAX_CAPACITY, "INITIAL_CAPACITY is too large");
-  BOOST_ASSERT_MSG(static_cast<size_t>(MIN_CAPACITY * CAPACITY_UP) > MIN_CAPACITY,
-                   "CAPACITY_UP must be able to increase from MIN_CAPACITY");
-  BOOST_ASSERT_MSG(static_cast<size_t>(MAX_CAPACITY * CAPACITY_DOWN) < MAX_CAPACITY,
-                   "CAPACITY_DOWN must be able to decrease from MAX_CAPACITY");
-  BOOST_ASSERT_MSG(CAPACITY_UP > 1.0, "CAPACITY_UP must adjust up");
-  BOOST_ASSERT_MSG(CAPACITY_DOWN < 1.0, "CAPACITY_DOWN must adjust down");
-  static_assert(EVICT_LIMIT >= 1, "EVICT_LIMIT must be at least 1");
+  BOOST_ASSERT_MSG(DEFAULT_CAPACITY >= MIN_CAPACITY, "DEFAULT_CAPACITY is too small");
+  BOOST_ASSERT_MSG(EXPECTED_MARK_COUNT >= 1, "EXPECTED_MARK_COUNT must be at least 1");
 }
 
 size_t
 DeadNonceList::size() const
 {
-  return m_queue.size() - this->countMarks();
+  return static_cast<size_t>(m_nAdded - m_nEvicted);
 }
 
 bool
 DeadNonceList::has(const Name& name, uint32_t nonce) const
 {
+  if (m_queue.empty()) { // nothing has been added
+    return false;
+  }
+
   Entry entry = DeadNonceList::makeEntry(name, nonce);
-  return m_ht.find(entry) != m_ht.end();
+  Fingerprint fp = makeFingerprint(entry);
+  size_t bucket1 = this->getBucket(entry);
+  size_t bucket2 = this->getAltBucket(bucket1, fp);
+
+  if (m_hasVictim && m_victim == fp &&
+      (m_victimBucket == bucket1 || m_victimBucket == bucket2)) {
+    return true;
+  }
+  return this->hasInBucket(bucket1, fp) || this->hasInBucket(bucket2, fp);
 }
 
 void
 DeadNonceList::add(const Name& name, uint32_t nonce)
 {
+  if (m_queue.empty()) {
+    this->allocate();
+  }
+  if (m_markEvent == nullptr) {
+    m_markEvent = scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
+  }
+
+  // make room: ring is full, or the filter could not place a fingerprint last time
+  while (this->size() >= m_capacity || (m_hasVictim && this->size() > 0)) {
+    this->evictOldest();
+  }
+
   Entry entry = DeadNonceList::makeEntry(name, nonce);
-  m_queue.push_back(entry);
+  m_queue[m_nAdded & (m_capacity - 1)] = entry;
+  ++m_nAdded;
 
-  this->evictEntries();
+  if (!this->insertToFilter(entry)) {
+    NFD_LOG_TRACE("add filter-full size=" << this->size());
+  }
 }
 
 DeadNonceList::Entry
@@ -110,62 +136,161 @@ DeadNonceList::makeEntry(const Name& name, uint32_t nonce)
                             static_cast<uint64_t>(nonce));
 }
 
+DeadNonceList::Fingerprint
+DeadNonceList::makeFingerprint(Entry entry)
+{
+  // high bits of the hash, independent of the low bits used for bucket index
+  Fingerprint fp = static_cast<Fingerprint>(entry >> 48);
+  return fp == 0 ? 1 : fp;
+}
+
 size_t
-DeadNonceList::countMarks() const
+DeadNonceList::getBucket(Entry entry) const
 {
-  return m_ht.count(MARK);
+  return static_cast<size_t>(entry) & m_bucketMask;
 }
 
-void
-DeadNonceList::mark()
+size_t
+DeadNonceList::getAltBucket(size_t bucket, Fingerprint fp) const
+{
+  // partial-key cuckoo hashing: alternate bucket is derived from fingerprint only,
+  // so that a fingerprint can be relocated without knowing the original entry
+  uint64_t fpHash = static_cast<uint64_t>(fp) * 0x5bd1e995;
+  return (bucket ^ static_cast<size_t>(fpHash)) & m_bucketMask;
+}
+
+bool
+DeadNonceList::hasInBucket(size_t bucket, Fingerprint fp) const
+{
+  const Fingerprint* slots = &m_table[bucket * BUCKET_SIZE];
+  return std::find(slots, slots + BUCKET_SIZE, fp) != slots + BUCKET_SIZE;
+}
+
+bool
+DeadNonceList::insertToBucket(size_t bucket, Fingerprint fp)
+{
+  Fingerprint* slots = &m_table[bucket * BUCKET_SIZE];
+  Fingerprint* empty = std::find(slots, slots + BUCKET_SIZE, 0);
+  if (empty == slots + BUCKET_SIZE) {
+    return false;
+  }
+  *empty = fp;
+  return true;
+}
+
+bool
+DeadNonceList::eraseFromBucket(size_t bucket, Fingerprint fp)
+{
+  Fingerprint* slots = &m_table[bucket * BUCKET_SIZE];
+  Fingerprint* found = std::find(slots, slots + BUCKET_SIZE, fp);
+  if (found == slots + BUCKET_SIZE) {
+    return false;
+  }
+  *found = 0;
+  return true;
+}
+
+bool
+DeadNonceList::insertToFilter(Entry entry)
 {
-  m_queue.push_back(MARK);
-  size_t nMarks = this->countMarks();
-  m_actualMarkCounts.insert(nMarks);
+  BOOST_ASSERT(!m_hasVictim);
 
-  NFD_LOG_TRACE("mark nMarks=" << nMarks);
+  Fingerprint fp = makeFingerprint(entry);
+  size_t bucket = this->getBucket(entry);
+  if (this->insertToBucket(bucket, fp)) {
+    return true;
+  }
+  bucket = this->getAltBucket(bucket, fp);
+  if (this->insertToBucket(bucket, fp)) {
+    return true;
+  }
+
+  // relocate existing fingerprints; slot choice is derived from the entry hash,
+  // which keeps the simulation deterministic
+  uint64_t slotSeq = entry;
+  for (size_t kick = 0; kick < MAX_KICKS; ++kick) {
+    Fingerprint& slot = m_table[bucket * BUCKET_SIZE + (slotSeq % BUCKET_SIZE)];
+    slotSeq = slotSeq / BUCKET_SIZE + 1;
+    std::swap(fp, slot);
+    bucket = this->getAltBucket(bucket, fp);
+    if (this->insertToBucket(bucket, fp)) {
+      return true;
+    }
+  }
 
-  scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
+  m_hasVictim = true;
+  m_victimBucket = bucket;
+  m_victim = fp;
+  return false;
 }
 
 void
-DeadNonceList::adjustCapacity()
+DeadNonceList::eraseFromFilter(Entry entry)
 {
-  std::pair<std::multiset<size_t>::iterator, std::multiset<size_t>::iterator> equalRange =
-    m_actualMarkCounts.equal_range(EXPECTED_MARK_COUNT);
+  Fingerprint fp = makeFingerprint(entry);
+  size_t bucket1 = this->getBucket(entry);
+  size_t bucket2 = this->getAltBucket(bucket1, fp);
 
-  if (equalRange.second == m_actualMarkCounts.begin()) {
-    // all counts are above expected count, adjust down
-    m_capacity = std::max(MIN_CAPACITY,
-                          static_cast<size_t>(m_capacity * CAPACITY_DOWN));
-    NFD_LOG_TRACE("adjustCapacity DOWN capacity=" << m_capacity);
+  if (m_hasVictim && m_victim == fp &&
+      (m_victimBucket == bucket1 || m_victimBucket == bucket2)) {
+    m_hasVictim = false;
+    return;
   }
-  else if (equalRange.first == m_actualMarkCounts.end()) {
-    // all counts are below expected count, adjust up
-    m_capacity = std::min(MAX_CAPACITY,
-                          static_cast<size_t>(m_capacity * CAPACITY_UP));
-    NFD_LOG_TRACE("adjustCapacity UP capacity=" << m_capacity);
+  if (!this->eraseFromBucket(bucket1, fp)) {
+    this->eraseFromBucket(bucket2, fp);
   }
 
-  m_actualMarkCounts.clear();
+  // a slot has been freed; try to place the victim again
+  if (m_hasVictim) {
+    size_t victimBucket2 = this->getAltBucket(m_victimBucket, m_victim);
+    if (this->insertToBucket(m_victimBucket, m_victim) ||
+        this->insertToBucket(victimBucket2, m_victim)) {
+      m_hasVictim = false;
+    }
+  }
+}
 
-  this->evictEntries();
+void
+DeadNonceList::allocate()
+{
+  // two slots per stored entry keeps the filter at most half full,
+  // where cuckoo insertion virtually never fails
+  size_t nBuckets = m_capacity * 2 / BUCKET_SIZE;
+  m_queue.resize(m_capacity);
+  m_table.assign(nBuckets * BUCKET_SIZE, 0);
+  m_bucketMask = nBuckets - 1;
 
-  m_adjustCapacityEvent = scheduler::schedule(m_adjustCapacityInterval,
-                                              bind(&DeadNonceList::adjustCapacity, this));
+  NFD_LOG_TRACE("allocate capacity=" << m_capacity << " buckets=" << nBuckets);
 }
 
 void
-DeadNonceList::evictEntries()
+DeadNonceList::evictOldest()
 {
-  ssize_t nOverCapacity = m_queue.size() - m_capacity;
-  if (nOverCapacity <= 0) // not over capacity
-    return;
+  BOOST_ASSERT(this->size() > 0);
+  this->eraseFromFilter(m_queue[m_nEvicted & (m_capacity - 1)]);
+  ++m_nEvicted;
+}
+
+void
+DeadNonceList::mark()
+{
+  // the MARK being overwritten was recorded one lifetime ago
+  uint64_t expiredBefore = m_marks[m_markPos];
+  m_marks[m_markPos] = m_nAdded;
+  m_markPos = (m_markPos + 1) % EXPECTED_MARK_COUNT;
+
+  while (m_nEvicted < expiredBefore) {
+    this->evictOldest();
+  }
+
+  NFD_LOG_TRACE("mark size=" << this->size());
 
-  for (ssize_t nEvict = std::min<ssize_t>(nOverCapacity, EVICT_LIMIT); nEvict > 0; --nEvict) {
-    m_queue.erase(m_queue.begin());
+  if (this->size() == 0) {
+    // idle: stop marking until next add
+    m_markEvent.reset();
+    return;
   }
-  BOOST_ASSERT(m_queue.size() >= m_capacity);
+  m_markEvent = scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
 }
 
 } // namespace nfd
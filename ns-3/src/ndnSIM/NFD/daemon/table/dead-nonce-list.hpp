@@ -27,9 +27,6 @@
 #define NFD_DAEMON_TABLE_DEAD_NONCE_LIST_HPP
 
 #include "core/common.hpp"
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/sequenced_index.hpp>
-#include <boost/multi_index/hashed_index.hpp>
 #include "core/scheduler.hpp"
 
 namespace nfd {
@@ -40,16 +37,19 @@ namespace nfd {
  *  When a Nonce is erased (dead) from PIT entry, the Nonce and the Interest Name is added to
  *  Dead Nonce List, and kept for a duration in which most loops are expected to have occured.
  *
- *  To reduce memory usage, the Interest Name and Nonce are stored as a 64-bit hash.
+ *  To reduce memory usage, the Interest Name and Nonce are stored as a 64-bit hash,
+ *  and membership is answered by a cuckoo filter over 16-bit fingerprints of that hash.
  *  There could be false positives (non-looping Interest could be considered looping),
  *  but the probability is small, and the error is recoverable when consumer retransmits
  *  with a different Nonce.
  *
- *  To reduce memory usage, entries do not have associated timestamps. Instead,
- *  lifetime of entries is controlled by dynamically adjusting the capacity of the container.
- *  At fixed intervals, the MARK, an entry with a special value, is inserted into the container.
- *  The number of MARKs stored in the container reflects the lifetime of entries,
- *  because MARKs are inserted at fixed intervals.
+ *  Memory footprint is fixed by the capacity given at construction, and is only allocated
+ *  when the first Nonce is added. The hashes are also kept in a FIFO ring, so that the
+ *  oldest entry can be erased from the filter when the list is full.
+ *  Entries do not have associated timestamps. Instead, at fixed intervals the current
+ *  insertion position is recorded as a MARK; entries inserted before the MARK recorded
+ *  EXPECTED_MARK_COUNT intervals ago are older than lifetime and are erased in bulk.
+ *  All operations are O(1), except that expiry is amortized over insertions.
  */
 class DeadNonceList : noncopyable
 {
@@ -59,10 +59,13 @@ public:
    *         must be no less than MIN_LIFETIME.
    *         This should be set to the duration in which most loops would have occured.
    *         A loop cannot be detected if delay of the cycle is greater than lifetime.
+   *  \param capacity maximum number of stored Nonces, rounded up to a power of two;
+   *         when full, the oldest Nonce is evicted
    *  \throw std::invalid_argument if lifetime is less than MIN_LIFETIME
    */
   explicit
-  DeadNonceList(const time::nanoseconds& lifetime = DEFAULT_LIFETIME);
+  DeadNonceList(const time::nanoseconds& lifetime = DEFAULT_LIFETIME,
+                size_t capacity = DEFAULT_CAPACITY);
 
   ~DeadNonceList();
 
@@ -78,7 +81,6 @@ public:
   add(const Name& name, uint32_t nonce);
 
   /** \return number of stored Nonces
-   *  \note The return value does not contain non-Nonce entries in the index, if any.
    */
   size_t
   size() const;
@@ -88,48 +90,65 @@ public:
   const time::nanoseconds&
   getLifetime() const;
 
-private: // Entry and Index
+  /** \return maximum number of stored Nonces
+   */
+  size_t
+  getCapacity() const;
+
+private: // Entry
   typedef uint64_t Entry;
 
   static Entry
   makeEntry(const Name& name, uint32_t nonce);
 
-  typedef boost::multi_index_container<
-    Entry,
-    boost::multi_index::indexed_by<
-      boost::multi_index::sequenced<>,
-      boost::multi_index::hashed_non_unique<
-        boost::multi_index::identity<Entry>
-      >
-    >
-  > Index;
-
-  typedef Index::nth_index<0>::type Queue;
-  typedef Index::nth_index<1>::type Hashtable;
-
-private: // actual lifetime estimation and capacity control
-  /** \return number of MARKs in the index
+private: // cuckoo filter
+  /** \brief fingerprint of an Entry stored in the filter; zero denotes an empty slot
    */
+  typedef uint16_t Fingerprint;
+
+  static Fingerprint
+  makeFingerprint(Entry entry);
+
   size_t
-  countMarks() const;
+  getBucket(Entry entry) const;
+
+  size_t
+  getAltBucket(size_t bucket, Fingerprint fp) const;
+
+  bool
+  hasInBucket(size_t bucket, Fingerprint fp) const;
+
+  bool
+  insertToBucket(size_t bucket, Fingerprint fp);
 
-  /** \brief add a MARK, then record number of MARKs in m_actualMarkCounts
+  bool
+  eraseFromBucket(size_t bucket, Fingerprint fp);
+
+  /** \brief insert entry into the filter, relocating existing fingerprints if necessary
+   *  \return false if the filter is too full; the last relocated fingerprint is then
+   *          kept in the victim slot
    */
+  bool
+  insertToFilter(Entry entry);
+
   void
-  mark();
+  eraseFromFilter(Entry entry);
 
-  /** \brief adjust capacity according to m_actualMarkCounts
-   *
-   *  If all counts are above EXPECTED_MARK_COUNT, reduce capacity to m_capacity * CAPACITY_DOWN.
-   *  If all counts are below EXPECTED_MARK_COUNT, increase capacity to m_capacity * CAPACITY_UP.
+private: // FIFO and lifetime control
+  /** \brief allocate the ring and the filter, and start marking
    */
   void
-  adjustCapacity();
+  allocate();
 
-  /** \brief evict some entries if index is over capacity
+  /** \brief evict the oldest entry
    */
   void
-  evictEntries();
+  evictOldest();
+
+  /** \brief record insertion position as a MARK, and evict entries older than lifetime
+   */
+  void
+  mark();
 
 public:
   /// default entry lifetime
@@ -138,77 +157,47 @@ public:
   /// minimum entry lifetime
   static const time::nanoseconds MIN_LIFETIME;
 
+  /// default maximum number of stored Nonces
+  static const size_t DEFAULT_CAPACITY;
+
 private:
   time::nanoseconds m_lifetime;
-  Index m_index;
-  Queue& m_queue;
-  Hashtable& m_ht;
-
-PUBLIC_WITH_TESTS_ELSE_PRIVATE: // actual lifetime estimation and capacity control
-
-  // ---- current capacity and hard limits
-
-  /** \brief current capacity of index
-   *
-   *  The index size is maintained to be near this capacity.
-   *
-   *  The capacity is adjusted so that every Entry is expected to be kept for m_lifetime.
-   *  This is achieved by mark() and adjustCapacity().
-   */
   size_t m_capacity;
 
-  static const size_t INITIAL_CAPACITY;
-
-  /** \brief minimum capacity
+  /** \brief ring of stored entries in insertion order
    *
-   *  This is to ensure correct algorithm operations.
+   *  Entry with insertion sequence i is stored at m_queue[i % m_capacity].
    */
-  static const size_t MIN_CAPACITY;
+  std::vector<Entry> m_queue;
+  uint64_t m_nAdded; ///< insertion sequence of next entry
+  uint64_t m_nEvicted; ///< insertion sequence of oldest stored entry
 
-  /** \brief maximum capacity
-   *
-   *  This is to limit memory usage.
-   */
-  static const size_t MAX_CAPACITY;
+  std::vector<Fingerprint> m_table; ///< m_nBuckets * BUCKET_SIZE fingerprints
+  size_t m_bucketMask;
 
-  // ---- actual entry lifetime estimation
+  bool m_hasVictim;
+  size_t m_victimBucket;
+  Fingerprint m_victim;
 
-  /** \brief the MARK for capacity
-   *
-   *  The MARK doesn't have a distinct type.
-   *  Entry is a hash. The hash function should have non-invertible property,
-   *  so it's unlikely for a usual Entry to have collision with the MARK.
+  static const size_t BUCKET_SIZE;
+
+  /** \brief maximum relocations before an insertion is considered failed
    */
-  static const Entry MARK;
+  static const size_t MAX_KICKS;
 
-  /** \brief expected number of MARKs in the index
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /** \brief number of MARKs in a lifetime
    */
   static const size_t EXPECTED_MARK_COUNT;
 
-  /** \brief number of MARKs in the index after each MARK insertion
-   *
-   *  adjustCapacity uses this to determine whether and how to adjust capcity,
-   *  and then clears this list.
+  /** \brief m_nAdded recorded at each of the last EXPECTED_MARK_COUNT MARKs (ring)
    */
-  std::multiset<size_t> m_actualMarkCounts;
+  std::vector<uint64_t> m_marks;
+  size_t m_markPos;
 
   time::nanoseconds m_markInterval;
 
   scheduler::EventId m_markEvent;
-
-  // ---- capacity adjustments
-
-  static const double CAPACITY_UP;
-
-  static const double CAPACITY_DOWN;
-
-  time::nanoseconds m_adjustCapacityInterval;
-
-  scheduler::EventId m_adjustCapacityEvent;
-
-  /** \brief maximum number of entries to evict at each operation if index is over capacity
-   */
-  static const size_t EVICT_LIMIT;
 };
 
 inline const time::nanoseconds&
@@ -217,6 +206,12 @@ DeadNonceList::getLifetime() const
   return m_lifetime;
 }
 
+inline size_t
+DeadNonceList::getCapacity() const
+{
+  return m_capacity;
+}
+
 } // namespace nfd
 
 #endif // NFD_DAEMON_TABLE_DEAD_NONCE_LIST_HPP
@@ -32,6 +32,8 @@ Entry::Entry(const Name& name, Node* node)
   : m_name(name)
   , m_node(node)
   , m_parent(nullptr)
+  , m_cachedStrategy(nullptr)
+  , m_cachedStrategyGeneration(0)
 {
   BOOST_ASSERT(node != nullptr);
 }
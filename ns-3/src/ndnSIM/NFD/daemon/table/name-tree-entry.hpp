@@ -152,6 +152,25 @@ public: // attached table entries
   void
   setStrategyChoiceEntry(unique_ptr<strategy_choice::Entry> strategyChoiceEntry);
 
+public: // effective strategy cache
+  /** \return cached effective strategy of this entry,
+   *          or nullptr if the cache was filled under a different \p generation
+   *  \note This is maintained by StrategyChoice; other components should call
+   *        StrategyChoice::findEffectiveStrategy instead.
+   */
+  fw::Strategy*
+  getCachedStrategy(uint64_t generation) const
+  {
+    return m_cachedStrategyGeneration == generation ? m_cachedStrategy : nullptr;
+  }
+
+  void
+  setCachedStrategy(fw::Strategy& strategy, uint64_t generation) const
+  {
+    m_cachedStrategy = &strategy;
+    m_cachedStrategyGeneration = generation;
+  }
+
   /** \return name tree entry on which a table entry is attached,
    *          or nullptr if the table entry is detached
    *  \note This function is for NameTree internal use. Other components
@@ -175,6 +194,9 @@ private:
   unique_ptr<measurements::Entry> m_measurementsEntry;
   unique_ptr<strategy_choice::Entry> m_strategyChoiceEntry;
 
+  mutable fw::Strategy* m_cachedStrategy;
+  mutable uint64_t m_cachedStrategyGeneration;
+
   friend Node* getNode(const Entry& entry);
 };
 
@@ -195,6 +195,22 @@ public:
     return m_buckets[bucket]; // don't use m_bucket.at() for better performance
   }
 
+  /** \brief hint that the bucket for hash value h is about to be searched
+   *
+   *  This issues a prefetch of the first node in the bucket, so that lookups of several
+   *  names can overlap their cache misses.
+   */
+  void
+  prefetch(HashValue h) const
+  {
+    const Node* node = m_buckets[this->computeBucketIndex(h)];
+#if defined(__GNUC__)
+    __builtin_prefetch(node);
+#else
+    (void)node;
+#endif
+  }
+
   /** \brief find node for name.getPrefix(prefixLen)
    *  \pre name.size() > prefixLen
    */
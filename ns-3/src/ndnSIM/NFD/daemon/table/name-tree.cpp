@@ -144,6 +144,12 @@ NameTree::eraseIfEmpty(Entry* entry, bool canEraseAncestors)
   return nErased;
 }
 
+void
+NameTree::prefetch(const Name& name) const
+{
+  m_ht.prefetch(computeHash(name));
+}
+
 Entry*
 NameTree::findExactMatch(const Name& name) const
 {
@@ -118,6 +118,14 @@ public: // mutation
   eraseIfEmpty(Entry* entry, bool canEraseAncestors = true);
 
 public: // matching
+  /** \brief hint that an entry with \p name is about to be looked up or inserted
+   *
+   *  Only the bucket of the full name is prefetched: shorter prefixes are usually
+   *  shared by many names and already cached.
+   */
+  void
+  prefetch(const Name& name) const;
+
   /** \brief exact match lookup
    *  \return entry with \p name, or nullptr if it does not exist
    */
@@ -31,21 +31,38 @@
 #include "core/scheduler.hpp"
 #include "fib-entry.hpp"
 
+#include <boost/container/small_vector.hpp>
+
 namespace nfd {
 
+namespace fw {
+class Strategy;
+} // namespace fw
+
 namespace name_tree {
 class Entry;
 } // namespace name_tree
 
 namespace pit {
 
+/** \brief number of face records stored inline in a PIT entry
+ *
+ *  Most PIT entries have one or two downstreams and upstreams. Records up to this
+ *  number are allocated together with the PIT entry; more records fall back to the heap.
+ */
+static const size_t N_INLINE_FACE_RECORDS = 2;
+
 /** \brief an unordered collection of in-records
+ *  \warning Inserting or deleting an in-record invalidates iterators and references
+ *           to other in-records.
  */
-typedef std::list<InRecord> InRecordCollection;
+typedef boost::container::small_vector<InRecord, N_INLINE_FACE_RECORDS> InRecordCollection;
 
 /** \brief an unordered collection of out-records
+ *  \warning Inserting or deleting an out-record invalidates iterators and references
+ *           to other out-records.
  */
-typedef std::list<OutRecord> OutRecordCollection;
+typedef boost::container::small_vector<OutRecord, N_INLINE_FACE_RECORDS> OutRecordCollection;
 
 /** \brief an Interest table entry
  *
@@ -228,6 +245,25 @@ public: // out-record
 	  m_selectedInstance = selectedInstance;
   }
 
+public: // effective strategy cache
+  /** \return cached effective strategy of this entry,
+   *          or nullptr if the cache was filled under a different \p generation
+   *  \note This is maintained by StrategyChoice; forwarding should call
+   *        StrategyChoice::findEffectiveStrategy instead.
+   */
+  fw::Strategy*
+  getCachedStrategy(uint64_t generation) const
+  {
+    return m_cachedStrategyGeneration == generation ? m_cachedStrategy : nullptr;
+  }
+
+  void
+  setCachedStrategy(fw::Strategy& strategy, uint64_t generation) const
+  {
+    m_cachedStrategy = &strategy;
+    m_cachedStrategyGeneration = generation;
+  }
+
 public:
   /** \brief unsatisfy timer
    *
@@ -258,6 +294,9 @@ private:
   name_tree::Entry* m_nameTreeEntry;
   fib::Entry* m_selectedInstance = nullptr;
 
+  mutable fw::Strategy* m_cachedStrategy = nullptr;
+  mutable uint64_t m_cachedStrategyGeneration = 0;
+
   friend class name_tree::Entry;
 };
 
@@ -70,7 +70,8 @@ public:
   update(const Interest& interest);
 
 private:
-  Face& m_face;
+  Face* m_face; // pointer rather than reference, so that records are assignable
+                // and can be stored inline in a vector
   uint32_t m_lastNonce;
   time::steady_clock::TimePoint m_lastRenewed;
   time::steady_clock::TimePoint m_expiry;
@@ -80,7 +81,7 @@ private:
 inline Face&
 FaceRecord::getFace() const
 {
-  return m_face;
+  return *m_face;
 }
 
 inline uint32_t
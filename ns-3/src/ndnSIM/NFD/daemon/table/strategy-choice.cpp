@@ -26,6 +26,7 @@
 #include "strategy-choice.hpp"
 #include "core/logger.hpp"
 #include "fw/strategy.hpp"
+#include "fw/strategy-registry.hpp"
 #include "pit-entry.hpp"
 #include "measurements-entry.hpp"
 
@@ -45,6 +46,8 @@ nteHasStrategyChoiceEntry(const name_tree::Entry& nte)
 StrategyChoice::StrategyChoice(NameTree& nameTree, unique_ptr<Strategy> defaultStrategy)
   : m_nameTree(nameTree)
   , m_nItems(0)
+  , m_generation(1)
+  , m_forwarder(nullptr)
 {
   this->setDefaultStrategy(std::move(defaultStrategy));
 }
@@ -52,12 +55,12 @@ StrategyChoice::StrategyChoice(NameTree& nameTree, unique_ptr<Strategy> defaultS
 bool
 StrategyChoice::hasStrategy(const Name& strategyName, bool isExact) const
 {
-  if (isExact) {
-    return m_strategyInstances.count(strategyName) > 0;
-  }
-  else {
-    return this->getStrategy(strategyName) != nullptr;
+  bool isInstalled = isExact ? m_strategyInstances.count(strategyName) > 0 :
+                               this->getStrategy(strategyName) != nullptr;
+  if (isInstalled || m_forwarder == nullptr) {
+    return isInstalled;
   }
+  return !fw::findRegisteredStrategy(strategyName, isExact).empty();
 }
 
 std::pair<bool, Strategy*>
@@ -77,6 +80,12 @@ StrategyChoice::install(unique_ptr<Strategy> strategy)
   return std::make_pair(isInserted, it->second.get());
 }
 
+void
+StrategyChoice::enableOnDemandInstallation(Forwarder& forwarder)
+{
+  m_forwarder = &forwarder;
+}
+
 Strategy*
 StrategyChoice::getStrategy(const Name& strategyName) const
 {
@@ -94,10 +103,23 @@ StrategyChoice::getStrategy(const Name& strategyName) const
   return candidate;
 }
 
+Strategy*
+StrategyChoice::getOrInstallStrategy(const Name& strategyName)
+{
+  if (m_forwarder != nullptr) {
+    Name registeredName = fw::findRegisteredStrategy(strategyName);
+    if (!registeredName.empty() && m_strategyInstances.count(registeredName) == 0) {
+      NFD_LOG_DEBUG("instantiating " << registeredName);
+      this->install(fw::makeStrategy(registeredName, *m_forwarder));
+    }
+  }
+  return this->getStrategy(strategyName);
+}
+
 bool
 StrategyChoice::insert(const Name& prefix, const Name& strategyName)
 {
-  Strategy* strategy = this->getStrategy(strategyName);
+  Strategy* strategy = this->getOrInstallStrategy(strategyName);
   if (strategy == nullptr) {
     NFD_LOG_ERROR("insert(" << prefix << "," << strategyName << ") strategy not installed");
     return false;
@@ -127,6 +149,7 @@ StrategyChoice::insert(const Name& prefix, const Name& strategyName)
 
   this->changeStrategy(*entry, *oldStrategy, *strategy);
   entry->setStrategy(*strategy);
+  ++m_generation;
   return true;
 }
 
@@ -153,6 +176,7 @@ StrategyChoice::erase(const Name& prefix)
   nte->setStrategyChoiceEntry(nullptr);
   m_nameTree.eraseIfEmpty(nte);
   --m_nItems;
+  ++m_generation;
 }
 
 std::pair<bool, Name>
@@ -180,6 +204,17 @@ StrategyChoice::findEffectiveStrategyImpl(const K& key) const
   return nte->getStrategyChoiceEntry()->getStrategy();
 }
 
+Strategy&
+StrategyChoice::findEffectiveStrategyCached(const name_tree::Entry& nte) const
+{
+  Strategy* strategy = nte.getCachedStrategy(m_generation);
+  if (strategy == nullptr) {
+    strategy = &this->findEffectiveStrategyImpl(nte);
+    nte.setCachedStrategy(*strategy, m_generation);
+  }
+  return *strategy;
+}
+
 Strategy&
 StrategyChoice::findEffectiveStrategy(const Name& prefix) const
 {
@@ -189,13 +224,32 @@ StrategyChoice::findEffectiveStrategy(const Name& prefix) const
 Strategy&
 StrategyChoice::findEffectiveStrategy(const pit::Entry& pitEntry) const
 {
-  return this->findEffectiveStrategyImpl(pitEntry);
+  Strategy* strategy = pitEntry.getCachedStrategy(m_generation);
+  if (strategy != nullptr) {
+    return *strategy;
+  }
+
+  const name_tree::Entry* nte = m_nameTree.getEntry(pitEntry);
+  BOOST_ASSERT(nte != nullptr);
+  if (nte->getName().size() == pitEntry.getName().size()) {
+    strategy = &this->findEffectiveStrategyCached(*nte);
+  }
+  else {
+    // PIT entry with implicit digest is attached to a shorter name tree entry,
+    // whose cached strategy may differ from that of the full name
+    strategy = &this->findEffectiveStrategyImpl(pitEntry);
+  }
+
+  pitEntry.setCachedStrategy(*strategy, m_generation);
+  return *strategy;
 }
 
 Strategy&
 StrategyChoice::findEffectiveStrategy(const measurements::Entry& measurementsEntry) const
 {
-  return this->findEffectiveStrategyImpl(measurementsEntry);
+  const name_tree::Entry* nte = m_nameTree.getEntry(measurementsEntry);
+  BOOST_ASSERT(nte != nullptr);
+  return this->findEffectiveStrategyCached(*nte);
 }
 
 void
@@ -214,6 +268,7 @@ StrategyChoice::setDefaultStrategy(unique_ptr<Strategy> strategy)
   name_tree::Entry& nte = m_nameTree.lookup(Name());
   nte.setStrategyChoiceEntry(std::move(entry));
   ++m_nItems;
+  ++m_generation;
   NFD_LOG_INFO("setDefaultStrategy " << instance->getName());
 }
 
@@ -32,6 +32,9 @@
 #include <boost/range/adaptor/transformed.hpp>
 
 namespace nfd {
+
+class Forwarder;
+
 namespace strategy_choice {
 
 /** \brief represents the Strategy Choice table
@@ -73,6 +76,14 @@ public: // available Strategy types
   std::pair<bool, fw::Strategy*>
   install(unique_ptr<fw::Strategy> strategy);
 
+  /** \brief instantiate registered strategies on demand for \p forwarder
+   *
+   *  Afterwards, a strategy registered with NFD_REGISTER_STRATEGY counts as installed,
+   *  but is only instantiated the first time insert() chooses it.
+   */
+  void
+  enableOnDemandInstallation(Forwarder& forwarder);
+
 public: // Strategy Choice table
   /** \brief set strategy of prefix to be strategyName
    *  \param prefix the name prefix for which \p strategyName should be used
@@ -109,6 +120,8 @@ public: // effective strategy
   /** \brief get effective strategy for pitEntry
    *
    *  This is equivalent to .findEffectiveStrategy(pitEntry.getName())
+   *  \note The result is cached on the PIT entry and its name tree entry until
+   *        the Strategy Choice table is next modified.
    */
   fw::Strategy&
   findEffectiveStrategy(const pit::Entry& pitEntry) const;
@@ -116,6 +129,8 @@ public: // effective strategy
   /** \brief get effective strategy for measurementsEntry
    *
    *  This is equivalent to .findEffectiveStrategy(measurementsEntry.getName())
+   *  \note The result is cached on the name tree entry until
+   *        the Strategy Choice table is next modified.
    */
   fw::Strategy&
   findEffectiveStrategy(const measurements::Entry& measurementsEntry) const;
@@ -151,6 +166,13 @@ private:
   fw::Strategy*
   getStrategy(const Name& strategyName) const;
 
+  /** \brief get Strategy instance by strategyName, instantiating a registered strategy
+   *         if on-demand installation is enabled
+   *  \param strategyName a versioned or unversioned strategyName
+   */
+  fw::Strategy*
+  getOrInstallStrategy(const Name& strategyName);
+
   void
   setDefaultStrategy(unique_ptr<fw::Strategy> strategy);
 
@@ -165,6 +187,11 @@ private:
   fw::Strategy&
   findEffectiveStrategyImpl(const K& key) const;
 
+  /** \brief get effective strategy for a name tree entry, using its cache if still valid
+   */
+  fw::Strategy&
+  findEffectiveStrategyCached(const name_tree::Entry& nte) const;
+
   Range
   getRange() const;
 
@@ -172,8 +199,18 @@ private:
   NameTree& m_nameTree;
   size_t m_nItems;
 
+  /** \brief bumped whenever a strategy choice changes, invalidating all cached
+   *         effective strategies on name tree entries and PIT entries
+   */
+  uint64_t m_generation;
+
   typedef std::map<Name, unique_ptr<fw::Strategy>> StrategyInstanceTable;
   StrategyInstanceTable m_strategyInstances;
+
+  /** \brief forwarder that registered strategies are instantiated for,
+   *         nullptr if on-demand installation is disabled
+   */
+  Forwarder* m_forwarder;
 };
 
 } // namespace strategy_choice
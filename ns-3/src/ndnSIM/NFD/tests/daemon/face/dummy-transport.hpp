@@ -46,6 +46,7 @@ public:
                  ndn::nfd::LinkType linkType = ndn::nfd::LINK_TYPE_POINT_TO_POINT,
                  ssize_t mtu = MTU_UNLIMITED)
     : isClosed(false)
+    , sendQueueLength(QUEUE_UNSUPPORTED)
   {
     this->setLocalUri(FaceUri(localUri));
     this->setRemoteUri(FaceUri(remoteUri));
@@ -67,6 +68,12 @@ public:
     this->Transport::setState(state);
   }
 
+  virtual ssize_t
+  getSendQueueLength() override
+  {
+    return sendQueueLength;
+  }
+
   void
   receivePacket(Packet&& packet)
   {
@@ -102,6 +109,7 @@ private:
 
 public:
   bool isClosed;
+  ssize_t sendQueueLength;
   std::vector<Packet> sentPackets;
 };
 
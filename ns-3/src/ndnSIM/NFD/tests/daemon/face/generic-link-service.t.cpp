@@ -40,7 +40,7 @@ BOOST_AUTO_TEST_SUITE(Face)
 
 using nfd::Face;
 
-class GenericLinkServiceFixture : public BaseFixture
+class GenericLinkServiceFixture : public UnitTestTimeFixture
 {
 protected:
   GenericLinkServiceFixture()
@@ -723,6 +723,181 @@ BOOST_AUTO_TEST_CASE(ReceiveCongestionMarkNack)
 
 BOOST_AUTO_TEST_SUITE_END() // LpFields
 
+BOOST_AUTO_TEST_SUITE(CongestionMark)
+
+BOOST_AUTO_TEST_CASE(NoCongestion)
+{
+  GenericLinkService::Options options;
+  options.allowCongestionMarking = true;
+  options.defaultCongestionThreshold = 65536;
+  initialize(options);
+  transport->sendQueueLength = 32768;
+
+  for (int i = 0; i < 10; ++i) {
+    face->sendInterest(*makeInterest("/12345678"));
+    advanceClocks(time::milliseconds(50));
+  }
+
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 10);
+  for (const Transport::Packet& packet : transport->sentPackets) {
+    BOOST_CHECK(!lp::Packet(packet.packet).has<lp::CongestionMarkField>());
+  }
+  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 0);
+}
+
+BOOST_AUTO_TEST_CASE(QueueUnsupported)
+{
+  GenericLinkService::Options options;
+  options.allowCongestionMarking = true;
+  initialize(options);
+  transport->sendQueueLength = QUEUE_UNSUPPORTED;
+
+  for (int i = 0; i < 10; ++i) {
+    face->sendInterest(*makeInterest("/12345678"));
+    advanceClocks(time::milliseconds(50));
+  }
+
+  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 0);
+  BOOST_CHECK(service->m_nextMarkTime == time::steady_clock::TimePoint::max());
+}
+
+BOOST_AUTO_TEST_CASE(CoDelMarking)
+{
+  GenericLinkService::Options options;
+  options.allowCongestionMarking = true;
+  options.baseCongestionMarkingInterval = time::milliseconds(100);
+  options.defaultCongestionThreshold = 65536;
+  initialize(options);
+  transport->sendQueueLength = 65537;
+
+  // congestion starts, the first packet is not marked
+  time::steady_clock::TimePoint nextMarkTime = time::steady_clock::now() + time::milliseconds(100);
+  face->sendData(*makeData("/1"));
+  BOOST_CHECK(!lp::Packet(transport->sentPackets.back().packet).has<lp::CongestionMarkField>());
+  BOOST_CHECK(service->m_nextMarkTime == nextMarkTime);
+
+  // still within the first interval
+  advanceClocks(time::milliseconds(99));
+  face->sendData(*makeData("/2"));
+  BOOST_CHECK(!lp::Packet(transport->sentPackets.back().packet).has<lp::CongestionMarkField>());
+  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 0);
+
+  // queue stayed above threshold for one interval: mark, next mark after 100ms / sqrt(2)
+  advanceClocks(time::milliseconds(1));
+  face->sendData(*makeData("/3"));
+  BOOST_REQUIRE(lp::Packet(transport->sentPackets.back().packet).has<lp::CongestionMarkField>());
+  BOOST_CHECK_EQUAL(lp::Packet(transport->sentPackets.back().packet).get<lp::CongestionMarkField>(), 1);
+  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 1);
+  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 1);
+  nextMarkTime += time::nanoseconds(70710678);
+  BOOST_CHECK(service->m_nextMarkTime == nextMarkTime);
+
+  // second mark after the shortened interval
+  advanceClocks(time::milliseconds(71));
+  face->sendData(*makeData("/4"));
+  BOOST_CHECK(lp::Packet(transport->sentPackets.back().packet).has<lp::CongestionMarkField>());
+  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 2);
+  nextMarkTime += time::nanoseconds(57735026);
+  BOOST_CHECK(service->m_nextMarkTime == nextMarkTime);
+
+  // queue drops below threshold, the congestion incident ends
+  transport->sendQueueLength = 65536;
+  face->sendData(*makeData("/5"));
+  BOOST_CHECK(!lp::Packet(transport->sentPackets.back().packet).has<lp::CongestionMarkField>());
+  BOOST_CHECK(service->m_nextMarkTime == time::steady_clock::TimePoint::max());
+  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 0);
+  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // CongestionMark
+
+BOOST_AUTO_TEST_SUITE(Bundling)
+
+BOOST_AUTO_TEST_CASE(BundleWithinDelay)
+{
+  GenericLinkService::Options options;
+  options.allowBundling = true;
+  options.bundleMaxDelay = time::milliseconds(1);
+  initialize(options);
+
+  face->sendInterest(*makeInterest("/A"));
+  face->sendInterest(*makeInterest("/B"));
+  face->sendInterest(*makeInterest("/C"));
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 0);
+
+  advanceClocks(time::microseconds(500), 2);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  BOOST_CHECK_EQUAL(service->getCounters().nOutBundled, 3);
+
+  // the bundle frame is unbundled by the receiving side
+  Block frame = transport->sentPackets.back().packet;
+  BOOST_CHECK_EQUAL(frame.type(), lp::tlv::LpBundle);
+  transport->receivePacket(frame);
+  BOOST_CHECK_EQUAL(service->getCounters().nInBundled, 3);
+  BOOST_REQUIRE_EQUAL(receivedInterests.size(), 3);
+  BOOST_CHECK_EQUAL(receivedInterests[0].getName(), "/A");
+  BOOST_CHECK_EQUAL(receivedInterests[1].getName(), "/B");
+  BOOST_CHECK_EQUAL(receivedInterests[2].getName(), "/C");
+}
+
+BOOST_AUTO_TEST_CASE(SinglePacketNotBundled)
+{
+  GenericLinkService::Options options;
+  options.allowBundling = true;
+  initialize(options);
+
+  face->sendInterest(*makeInterest("/A"));
+  advanceClocks(options.bundleMaxDelay);
+
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  BOOST_CHECK_EQUAL(transport->sentPackets.back().packet.type(), lp::tlv::LpPacket);
+  BOOST_CHECK_EQUAL(service->getCounters().nOutBundled, 0);
+}
+
+BOOST_AUTO_TEST_CASE(SizeBudget)
+{
+  shared_ptr<Interest> interest = makeInterest("/A");
+  lp::Packet lpPacket(interest->wireEncode());
+  lpPacket.add<lp::HopCountTagField>(0);
+  size_t packetSize = lpPacket.wireEncode().size();
+
+  GenericLinkService::Options options;
+  options.allowBundling = true;
+  options.bundleMaxSize = 2 * packetSize + 4;
+  initialize(options);
+
+  // the third packet does not fit, so the first two leave as one bundle
+  face->sendInterest(*interest);
+  face->sendInterest(*interest);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 0);
+  face->sendInterest(*interest);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  BOOST_CHECK_EQUAL(transport->sentPackets.back().packet.type(), lp::tlv::LpBundle);
+
+  // a packet larger than the budget is sent alone, after the pending one
+  face->sendData(*makeData("/large/" + std::string(200, 'x')));
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 3);
+  BOOST_CHECK_EQUAL(transport->sentPackets[1].packet.type(), lp::tlv::LpPacket);
+  BOOST_CHECK_EQUAL(lp::Packet(transport->sentPackets[2].packet).get<lp::FragmentField>().first[0],
+                    tlv::Data);
+  BOOST_CHECK_EQUAL(service->getCounters().nOutBundled, 2);
+}
+
+BOOST_AUTO_TEST_CASE(ReceiveMalformedBundle)
+{
+  Block frame(lp::tlv::LpBundle);
+  frame.push_back(Name("/not-an-LpPacket").wireEncode());
+  frame.encode();
+
+  transport->receivePacket(frame);
+
+  BOOST_CHECK_EQUAL(service->getCounters().nInBundled, 1);
+  BOOST_CHECK_EQUAL(service->getCounters().nInLpInvalid, 1);
+  BOOST_CHECK_EQUAL(receivedInterests.size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Bundling
+
 
 BOOST_AUTO_TEST_SUITE(Malformed) // receive malformed packets
 
@@ -457,6 +457,68 @@ BOOST_AUTO_TEST_CASE(OverFragCount)
   BOOST_REQUIRE(!isComplete);
 }
 
+BOOST_AUTO_TEST_CASE(TooManyPartialPackets)
+{
+  LpReassembler::Options options;
+  options.nMaxPartialPackets = 2;
+  reassembler.setOptions(options);
+
+  ndn::Buffer data1Buffer(data, 5);
+  ndn::Buffer data2Buffer(data + 5, 5);
+
+  auto makeFrag = [] (const ndn::Buffer& buffer, uint64_t fragIndex, lp::Sequence seq) {
+    lp::Packet frag;
+    frag.add<lp::FragmentField>(std::make_pair(buffer.begin(), buffer.end()));
+    frag.add<lp::FragIndexField>(fragIndex);
+    frag.add<lp::FragCountField>(2);
+    frag.add<lp::SequenceField>(seq);
+    return frag;
+  };
+
+  bool isComplete = false;
+  std::tie(isComplete, std::ignore, std::ignore) =
+    reassembler.receiveFragment(0, makeFrag(data1Buffer, 0, 1000));
+  BOOST_REQUIRE(!isComplete);
+  std::tie(isComplete, std::ignore, std::ignore) =
+    reassembler.receiveFragment(0, makeFrag(data1Buffer, 0, 2000));
+  BOOST_REQUIRE(!isComplete);
+  BOOST_CHECK_EQUAL(reassembler.size(), 2);
+
+  // table is full: first fragment of another packet is dropped
+  std::tie(isComplete, std::ignore, std::ignore) =
+    reassembler.receiveFragment(0, makeFrag(data1Buffer, 0, 3000));
+  BOOST_REQUIRE(!isComplete);
+  BOOST_CHECK_EQUAL(reassembler.size(), 2);
+  std::tie(isComplete, std::ignore, std::ignore) =
+    reassembler.receiveFragment(0, makeFrag(data2Buffer, 1, 3001));
+  BOOST_REQUIRE(!isComplete);
+  BOOST_CHECK_EQUAL(reassembler.size(), 2);
+
+  // fragments of packets already being reassembled are accepted
+  Block netPacket;
+  std::tie(isComplete, netPacket, std::ignore) =
+    reassembler.receiveFragment(0, makeFrag(data2Buffer, 1, 1001));
+  BOOST_REQUIRE(isComplete);
+  BOOST_CHECK_EQUAL_COLLECTIONS(data, data + 10, netPacket.begin(), netPacket.end());
+  BOOST_CHECK_EQUAL(reassembler.size(), 1);
+
+  // out of order
+  std::tie(isComplete, std::ignore, std::ignore) =
+    reassembler.receiveFragment(0, makeFrag(data2Buffer, 1, 4001));
+  BOOST_REQUIRE(!isComplete);
+  BOOST_CHECK_EQUAL(reassembler.size(), 2);
+
+  std::tie(isComplete, netPacket, std::ignore) =
+    reassembler.receiveFragment(0, makeFrag(data1Buffer, 0, 4000));
+  BOOST_REQUIRE(isComplete);
+  BOOST_CHECK_EQUAL_COLLECTIONS(data, data + 10, netPacket.begin(), netPacket.end());
+  BOOST_CHECK_EQUAL(reassembler.size(), 1);
+
+  advanceClocks(time::milliseconds(1), 600);
+  BOOST_CHECK_EQUAL(reassembler.size(), 0);
+  BOOST_CHECK_EQUAL(timeoutHistory.size(), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // MultiFragment
 
 BOOST_AUTO_TEST_SUITE(MultipleRemoteEndpoints)
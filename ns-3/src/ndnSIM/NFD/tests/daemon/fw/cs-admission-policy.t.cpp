@@ -0,0 +1,186 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/cs-admission-policy.hpp"
+#include "fw/forwarder.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+#include "tests/test-common.hpp"
+#include <boost/logic/tribool.hpp>
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+using namespace nfd::tests;
+
+class CsAdmissionPolicyFixture : public UnitTestTimeFixture
+{
+protected:
+  CsAdmissionPolicyFixture()
+    : cs(forwarder.getCs())
+    , localFace(make_shared<DummyFace>("dummy://", "dummy://", ndn::nfd::FACE_SCOPE_LOCAL))
+    , nonLocalFace1(make_shared<DummyFace>("dummy://", "dummy://", ndn::nfd::FACE_SCOPE_NON_LOCAL))
+    , nonLocalFace2(make_shared<DummyFace>("dummy://", "dummy://", ndn::nfd::FACE_SCOPE_NON_LOCAL))
+  {
+    forwarder.addFace(localFace);
+    forwarder.addFace(nonLocalFace1);
+    forwarder.addFace(nonLocalFace2);
+  }
+
+  /** \brief makes \p downstream request \p name, then returns the Data from \p upstream
+   */
+  shared_ptr<Data>
+  satisfy(const Name& name, Face& downstream, Face& upstream)
+  {
+    shared_ptr<Interest> interest = makeInterest(name);
+    shared_ptr<pit::Entry> pitEntry = forwarder.getPit().insert(*interest).first;
+    pitEntry->insertOrUpdateInRecord(downstream, *interest);
+    pitEntry->insertOrUpdateOutRecord(upstream, *interest);
+
+    shared_ptr<Data> data = makeData(name);
+    forwarder.onIncomingData(upstream, *data);
+    this->advanceClocks(time::milliseconds(1));
+    return data;
+  }
+
+  bool
+  isInCs(const Data& data)
+  {
+    using namespace boost::logic;
+
+    tribool isFound = indeterminate;
+    cs.find(Interest(data.getFullName()),
+      bind([&] { isFound = true; }),
+      bind([&] { isFound = false; }));
+
+    this->advanceClocks(time::milliseconds(1));
+    BOOST_REQUIRE(!indeterminate(isFound));
+    return static_cast<bool>(isFound);
+  }
+
+protected:
+  Forwarder forwarder;
+  Cs& cs;
+  shared_ptr<DummyFace> localFace;
+  shared_ptr<DummyFace> nonLocalFace1;
+  shared_ptr<DummyFace> nonLocalFace2;
+};
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestCsAdmissionPolicy, CsAdmissionPolicyFixture)
+
+BOOST_AUTO_TEST_CASE(DefaultAdmitsAll)
+{
+  shared_ptr<Data> data = satisfy("/A", *nonLocalFace1, *nonLocalFace2);
+  BOOST_CHECK(isInCs(*data));
+}
+
+BOOST_AUTO_TEST_CASE(Probabilistic)
+{
+  forwarder.setCsAdmissionPolicy(make_unique<ProbabilisticCsAdmissionPolicy>(0.0));
+  BOOST_CHECK(!isInCs(*satisfy("/A", *nonLocalFace1, *nonLocalFace2)));
+
+  forwarder.setCsAdmissionPolicy(make_unique<ProbabilisticCsAdmissionPolicy>(1.0));
+  BOOST_CHECK(isInCs(*satisfy("/B", *nonLocalFace1, *nonLocalFace2)));
+}
+
+BOOST_AUTO_TEST_CASE(TinyLfu)
+{
+  forwarder.setCsAdmissionPolicy(make_unique<TinyLfuCsAdmissionPolicy>(1024, 2));
+
+  // one-hit wonders are not cached, a second arrival of the same name is
+  shared_ptr<Data> data = satisfy("/A", *nonLocalFace1, *nonLocalFace2);
+  BOOST_CHECK(!isInCs(*data));
+  data = satisfy("/A", *nonLocalFace1, *nonLocalFace2);
+  BOOST_CHECK(isInCs(*data));
+}
+
+BOOST_AUTO_TEST_CASE(TinyLfuAging)
+{
+  TinyLfuCsAdmissionPolicy policy(1024, 2, 8);
+  shared_ptr<Data> dataA = makeData("/A");
+  pit::DataMatchResult noMatches;
+
+  for (int i = 0; i < 4; ++i) {
+    policy.admit(*nonLocalFace1, *dataA, noMatches);
+  }
+  BOOST_CHECK_EQUAL(policy.estimate("/A"), 4);
+
+  // the eighth arrival halves all counters
+  for (int i = 0; i < 4; ++i) {
+    policy.admit(*nonLocalFace1, *makeData(Name("/B").appendNumber(i)), noMatches);
+  }
+  BOOST_CHECK_EQUAL(policy.estimate("/A"), 2);
+  BOOST_CHECK_EQUAL(policy.estimate("/never-seen"), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Sfc)
+{
+  forwarder.setCsAdmissionPolicy(make_unique<SfcCsAdmissionPolicy>());
+
+  // Data produced by a local application
+  BOOST_CHECK(isInCs(*satisfy("/A", *nonLocalFace1, *localFace)));
+  // Data requested by a local application
+  BOOST_CHECK(isInCs(*satisfy("/B", *localFace, *nonLocalFace1)));
+  // transit Data
+  BOOST_CHECK(!isInCs(*satisfy("/C", *nonLocalFace1, *nonLocalFace2)));
+
+  forwarder.setCsAdmissionPolicy(make_unique<SfcCsAdmissionPolicy>(1.0));
+  BOOST_CHECK(isInCs(*satisfy("/D", *nonLocalFace1, *nonLocalFace2)));
+}
+
+BOOST_AUTO_TEST_CASE(SfcFunctionNode)
+{
+  ConfigSection section;
+  section.put("function_node", "yes");
+  forwarder.setCsAdmissionPolicy(CsAdmissionPolicy::create("sfc", section));
+
+  // Data processed by the function instance on this node transits it between routers
+  BOOST_CHECK(isInCs(*satisfy("/A", *nonLocalFace1, *nonLocalFace2)));
+
+  section.put("function_node", "maybe");
+  BOOST_CHECK_THROW(CsAdmissionPolicy::create("sfc", section), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_CASE(Create)
+{
+  ConfigSection section;
+  BOOST_CHECK(dynamic_cast<AdmitAllCsAdmissionPolicy*>(
+                CsAdmissionPolicy::create("admit-all", section).get()) != nullptr);
+  BOOST_CHECK(dynamic_cast<TinyLfuCsAdmissionPolicy*>(
+                CsAdmissionPolicy::create("tinylfu", section).get()) != nullptr);
+  BOOST_CHECK(CsAdmissionPolicy::create("unknown", section) == nullptr);
+
+  section.put("probability", "1.5");
+  BOOST_CHECK_THROW(CsAdmissionPolicy::create("probabilistic", section), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCsAdmissionPolicy
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
@@ -116,6 +116,44 @@ BOOST_AUTO_TEST_CASE(CsMatched)
   BOOST_CHECK_EQUAL(pit.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(CsMatchedFastPath)
+{
+  Forwarder forwarder;
+  forwarder.setCacheHitFastPathEnabled(true);
+
+  auto face1 = make_shared<DummyFace>();
+  auto face2 = make_shared<DummyFace>();
+  forwarder.addFace(face1);
+  forwarder.addFace(face2);
+
+  forwarder.getFib().insert("/A").first->addNextHop(*face2, 0);
+  forwarder.getCs().insert(*makeData("/A/1"));
+
+  int nSatisfied = 0;
+  forwarder.beforeSatisfyInterest.connect(
+    [&] (const pit::Entry& pitEntry, const Face& inFace, const Data& data) {
+      BOOST_CHECK_EQUAL(pitEntry.getName(), "/A/1");
+      BOOST_CHECK_EQUAL(inFace.getId(), face::FACEID_CONTENT_STORE);
+      ++nSatisfied;
+    });
+
+  // a cache hit is answered without PIT entry
+  face1->receiveInterest(*makeInterest("/A/1"));
+  this->advanceClocks(time::milliseconds(1), time::milliseconds(5));
+  BOOST_CHECK_EQUAL(face2->sentInterests.size(), 0);
+  BOOST_REQUIRE_EQUAL(face1->sentData.size(), 1);
+  BOOST_CHECK_EQUAL(*face1->sentData[0].getTag<lp::IncomingFaceIdTag>(), face::FACEID_CONTENT_STORE);
+  BOOST_CHECK_EQUAL(nSatisfied, 1);
+  BOOST_CHECK_EQUAL(forwarder.getPit().size(), 0);
+  BOOST_CHECK(forwarder.getNameTree().findExactMatch("/A/1") == nullptr);
+
+  // a cache miss is forwarded as usual
+  face1->receiveInterest(*makeInterest("/A/2"));
+  this->advanceClocks(time::milliseconds(1), time::milliseconds(5));
+  BOOST_CHECK_EQUAL(face2->sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(forwarder.getPit().size(), 1);
+}
+
 BOOST_AUTO_TEST_CASE(OutgoingInterest)
 {
   Forwarder forwarder;
@@ -332,6 +370,35 @@ BOOST_AUTO_TEST_CASE(IncomingData)
   BOOST_CHECK_EQUAL(face4->sentData.size(), 1);
 }
 
+BOOST_AUTO_TEST_CASE(DataRetrievalCost)
+{
+  Forwarder forwarder;
+  auto face1 = make_shared<DummyFace>();
+  auto face2 = make_shared<DummyFace>();
+  auto face3 = make_shared<DummyFace>();
+  forwarder.addFace(face1);
+  forwarder.addFace(face2);
+  forwarder.addFace(face3);
+
+  Pit& pit = forwarder.getPit();
+  shared_ptr<Interest> interestA = makeInterest("ndn:/A");
+  shared_ptr<pit::Entry> pitA = pit.insert(*interestA).first;
+  pitA->insertOrUpdateInRecord(*face1, *interestA);
+  pitA->insertOrUpdateOutRecord(*face3, *interestA);
+  this->advanceClocks(time::milliseconds(10), time::milliseconds(30));
+  pitA->insertOrUpdateOutRecord(*face2, *interestA);
+  this->advanceClocks(time::milliseconds(10), time::milliseconds(50));
+
+  // cost is measured from the out-record of the face the Data came from
+  shared_ptr<Data> dataA = makeData("ndn:/A");
+  forwarder.onIncomingData(*face2, *dataA);
+
+  const Cs& cs = forwarder.getCs();
+  BOOST_REQUIRE_EQUAL(cs.size(), 1);
+  BOOST_CHECK_EQUAL(cs.begin()->getRetrievalCost(), time::milliseconds(50));
+  BOOST_CHECK_EQUAL(cs.begin()->isUnsolicited(), false);
+}
+
 BOOST_AUTO_TEST_CASE(IncomingNack)
 {
   Forwarder forwarder;
@@ -482,6 +549,7 @@ BOOST_AUTO_TEST_CASE(OutgoingNack)
 BOOST_AUTO_TEST_CASE(InterestLoopNack)
 {
   Forwarder forwarder;
+  forwarder.setLoopDetectionEnabled(true);
   auto face1 = make_shared<DummyFace>();
   auto face2 = make_shared<DummyFace>();
   auto face3 = make_shared<DummyFace>("dummy://", "dummy://",
@@ -532,9 +600,120 @@ BOOST_AUTO_TEST_CASE(InterestLoopNack)
   BOOST_CHECK(face3->sentNacks.empty());
 }
 
+BOOST_AUTO_TEST_CASE(InterestLoopDetectionDisabled)
+{
+  Forwarder forwarder;
+  BOOST_CHECK_EQUAL(forwarder.isLoopDetectionEnabled(), false);
+  auto face1 = make_shared<DummyFace>();
+  auto face2 = make_shared<DummyFace>();
+  forwarder.addFace(face1);
+  forwarder.addFace(face2);
+
+  // receive Interest, then the same Interest again with duplicate Nonce on another face
+  shared_ptr<Interest> interest1 = makeInterest("/zT4XwK0Hnx/28JBUvbEzc", 732);
+  face1->receiveInterest(*interest1);
+  shared_ptr<Interest> interest2 = makeInterest("/zT4XwK0Hnx/28JBUvbEzc", 732);
+  face2->receiveInterest(*interest2);
+
+  BOOST_CHECK(face1->sentNacks.empty());
+  BOOST_CHECK(face2->sentNacks.empty());
+  BOOST_CHECK_EQUAL(forwarder.getDeadNonceList().size(), 0);
+}
+
+class InstanceSelectionTestForwarder : public Forwarder
+{
+public:
+  using Forwarder::selectFunctionInstance;
+};
+
+BOOST_AUTO_TEST_CASE(MeasuredInstanceSelectionChained)
+{
+  InstanceSelectionTestForwarder forwarder;
+  forwarder.setMeasuredInstanceSelectionEnabled(true);
+  auto face1 = make_shared<DummyFace>();
+  auto face2 = make_shared<DummyFace>();
+  forwarder.addFace(face1);
+  forwarder.addFace(face2);
+
+  Fib& fib = forwarder.getFib();
+  fib::Entry* instanceA = fib.insert("/F1a").first;
+  instanceA->addNextHop(*face1, 1);
+  fib::Entry* instanceB = fib.insert("/F1b").first;
+  instanceB->addNextHop(*face2, 2);
+
+  // the Interest names the chain /F1/F2, whose head function /F1 has instances /F1a and /F1b
+  Pit& pit = forwarder.getPit();
+  shared_ptr<pit::Entry> pitEntry1 = pit.insert(*makeInterest("/P/1")).first;
+  // without measurements, the instance is selected by FIB cost
+  BOOST_CHECK_EQUAL(forwarder.selectFunctionInstance("/F1/F2", pitEntry1), instanceA);
+  BOOST_CHECK_EQUAL(instanceA->getFcc(), 1);
+
+  fw::sfc::SfcMeasurements& sfcMeasurements = forwarder.getSfcMeasurements();
+  BOOST_CHECK_EQUAL(sfcMeasurements.getInstances("/F1").size(), 2);
+  sfcMeasurements.getOrCreateInstanceInfo("/F1a").recordRtt(time::milliseconds(50));
+  sfcMeasurements.getOrCreateInstanceInfo("/F1b").recordRtt(time::milliseconds(10));
+
+  shared_ptr<pit::Entry> pitEntry2 = pit.insert(*makeInterest("/P/2")).first;
+  BOOST_CHECK_EQUAL(forwarder.selectFunctionInstance("/F1/F2", pitEntry2), instanceB);
+  BOOST_CHECK_EQUAL(instanceA->getFcc(), 1);
+  BOOST_CHECK_EQUAL(instanceB->getFcc(), 1);
+
+  // the other instance of the head function is probed
+  this->advanceClocks(time::milliseconds(100), fw::sfc::SfcMeasurements::PROBING_INTERVAL);
+  shared_ptr<pit::Entry> pitEntry3 = pit.insert(*makeInterest("/P/3")).first;
+  BOOST_CHECK_EQUAL(forwarder.selectFunctionInstance("/F1/F2", pitEntry3), instanceB);
+  BOOST_CHECK_EQUAL(sfcMeasurements.takeProbeInstance(*pitEntry3), instanceA);
+
+  // measurements are kept for the head function, not for the chain
+  BOOST_CHECK(forwarder.getMeasurements().findExactMatch("/F1") != nullptr);
+  BOOST_CHECK(forwarder.getMeasurements().findExactMatch("/F1/F2") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(InterestBatching)
+{
+  Forwarder forwarder;
+  BOOST_CHECK_EQUAL(forwarder.isInterestBatchingEnabled(), false);
+  forwarder.setInterestBatchingEnabled(true);
+  auto face1 = make_shared<DummyFace>();
+  auto face2 = make_shared<DummyFace>();
+  forwarder.addFace(face1);
+  forwarder.addFace(face2);
+
+  Fib& fib = forwarder.getFib();
+  fib.insert("/A").first->addNextHop(*face2, 0);
+
+  // Interests are queued until the end of the current time
+  face1->receiveInterest(*makeInterest("/A/1"));
+  face1->receiveInterest(*makeInterest("/A/2"));
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInInterests, 0);
+  BOOST_CHECK_EQUAL(face2->sentInterests.size(), 0);
+
+  this->advanceClocks(time::milliseconds(1), time::milliseconds(5));
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInInterests, 2);
+  BOOST_REQUIRE_EQUAL(face2->sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(face2->sentInterests[0].getName(), "/A/1");
+  BOOST_CHECK_EQUAL(face2->sentInterests[1].getName(), "/A/2");
+
+  // queued Interests are processed before an incoming Data
+  face1->receiveInterest(*makeInterest("/A/3"));
+  face2->receiveData(*makeData("/A/3"));
+  BOOST_REQUIRE_EQUAL(face2->sentInterests.size(), 3);
+  BOOST_CHECK_EQUAL(face2->sentInterests[2].getName(), "/A/3");
+  BOOST_REQUIRE_EQUAL(face1->sentData.size(), 1);
+  BOOST_CHECK_EQUAL(face1->sentData[0].getName(), "/A/3");
+
+  // a queued Interest from a removed face is dropped
+  face1->receiveInterest(*makeInterest("/A/4"));
+  face1->close();
+  this->advanceClocks(time::milliseconds(1), time::milliseconds(5));
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInInterests, 3);
+  BOOST_CHECK_EQUAL(face2->sentInterests.size(), 3);
+}
+
 BOOST_FIXTURE_TEST_CASE(InterestLoopWithShortLifetime, UnitTestTimeFixture) // Bug 1953
 {
   Forwarder forwarder;
+  forwarder.setLoopDetectionEnabled(true);
   auto face1 = make_shared<DummyFace>();
   auto face2 = make_shared<DummyFace>();
   forwarder.addFace(face1);
@@ -573,6 +752,7 @@ BOOST_FIXTURE_TEST_CASE(InterestLoopWithShortLifetime, UnitTestTimeFixture) // B
 BOOST_AUTO_TEST_CASE(PitLeak) // Bug 3484
 {
   Forwarder forwarder;
+  forwarder.setLoopDetectionEnabled(true);
   shared_ptr<Face> face1 = make_shared<DummyFace>();
   forwarder.addFace(face1);
 
@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/sfc-measurements.hpp"
+#include "table/pit.hpp"
+
+#include "tests/daemon/face/dummy-face.hpp"
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace fw {
+namespace sfc {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_AUTO_TEST_SUITE(TestSfcMeasurements)
+
+BOOST_FIXTURE_TEST_CASE(InstanceInfoTimeout, BaseFixture)
+{
+  InstanceInfo info;
+  BOOST_CHECK(!info.hasSrttMeasurement());
+
+  info.recordRtt(time::milliseconds(20));
+  BOOST_CHECK(info.hasSrttMeasurement());
+  BOOST_CHECK(!info.isTimeout());
+  BOOST_CHECK_EQUAL(info.getTimeoutRatio(), 0.0);
+  asf::RttStats::Rtt expected = info.getExpectedServiceTime();
+
+  info.recordTimeout();
+  BOOST_CHECK(info.isTimeout());
+  BOOST_CHECK_GT(info.getTimeoutRatio(), 0.0);
+  BOOST_CHECK_GT(info.getExpectedServiceTime(), expected);
+
+  info.recordRtt(time::milliseconds(20));
+  BOOST_CHECK(!info.isTimeout());
+  BOOST_CHECK_LT(info.getTimeoutRatio(), InstanceInfo::TIMEOUT_RATIO_ALPHA);
+}
+
+class SfcMeasurementsFixture : public UnitTestTimeFixture
+{
+protected:
+  SfcMeasurementsFixture()
+    : fib(nameTree)
+    , pit(nameTree)
+    , measurements(nameTree)
+    , sfcMeasurements(fib, measurements)
+    , face1(make_shared<DummyFace>())
+    , face2(make_shared<DummyFace>())
+  {
+    fib.insert("/F1a").first->addNextHop(*face1, 1);
+    fib.insert("/F1b").first->addNextHop(*face2, 1);
+  }
+
+protected:
+  NameTree nameTree;
+  Fib fib;
+  Pit pit;
+  Measurements measurements;
+  SfcMeasurements sfcMeasurements;
+  shared_ptr<DummyFace> face1;
+  shared_ptr<DummyFace> face2;
+};
+
+BOOST_FIXTURE_TEST_CASE(SelectByServiceTime, SfcMeasurementsFixture)
+{
+  BOOST_CHECK_EQUAL(sfcMeasurements.getInstances("/F1").size(), 2);
+
+  shared_ptr<Interest> interest = makeInterest("/P/1");
+  shared_ptr<pit::Entry> pitEntry = pit.insert(*interest).first;
+  BOOST_CHECK(sfcMeasurements.selectInstance("/F1", *pitEntry) == nullptr);
+
+  sfcMeasurements.getOrCreateInstanceInfo("/F1a").recordRtt(time::milliseconds(50));
+  sfcMeasurements.getOrCreateInstanceInfo("/F1b").recordRtt(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(sfcMeasurements.selectInstance("/F1", *pitEntry)->getPrefix(), "/F1b");
+
+  sfcMeasurements.getOrCreateInstanceInfo("/F1b").recordTimeout();
+  BOOST_CHECK_EQUAL(sfcMeasurements.selectInstance("/F1", *pitEntry)->getPrefix(), "/F1a");
+}
+
+BOOST_FIXTURE_TEST_CASE(TrackCalls, SfcMeasurementsFixture)
+{
+  shared_ptr<Interest> interest1 = makeInterest("/P/1");
+  shared_ptr<pit::Entry> pitEntry1 = pit.insert(*interest1).first;
+  sfcMeasurements.selectInstance("/F1", *pitEntry1);
+  pitEntry1->insertOrUpdateOutRecord(*face1, *interest1);
+  sfcMeasurements.afterSendInterest(*pitEntry1, *face1, "/F1a");
+
+  shared_ptr<Interest> interest2 = makeInterest("/P/2");
+  shared_ptr<pit::Entry> pitEntry2 = pit.insert(*interest2).first;
+  sfcMeasurements.selectInstance("/F1", *pitEntry2);
+  pitEntry2->insertOrUpdateOutRecord(*face2, *interest2);
+  sfcMeasurements.afterSendInterest(*pitEntry2, *face2, "/F1b");
+
+  BOOST_CHECK_EQUAL(sfcMeasurements.getInstanceInfo("/F1a")->getOutstanding(), 1);
+  BOOST_CHECK_EQUAL(sfcMeasurements.getInstanceInfo("/F1b")->getOutstanding(), 1);
+
+  this->advanceClocks(time::milliseconds(10), 3);
+  sfcMeasurements.beforeSatisfyInterest(*pitEntry1, *face1);
+  sfcMeasurements.beforeFinalize(*pitEntry1, true);
+  InstanceInfo* infoA = sfcMeasurements.getInstanceInfo("/F1a");
+  BOOST_CHECK_EQUAL(infoA->getOutstanding(), 0);
+  BOOST_CHECK_EQUAL(infoA->getSrtt(), asf::RttStats::Rtt(time::milliseconds(30)));
+  BOOST_CHECK(!infoA->isTimeout());
+
+  sfcMeasurements.beforeFinalize(*pitEntry2, false);
+  InstanceInfo* infoB = sfcMeasurements.getInstanceInfo("/F1b");
+  BOOST_CHECK_EQUAL(infoB->getOutstanding(), 0);
+  BOOST_CHECK(infoB->isTimeout());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestSfcMeasurements
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace sfc
+} // namespace fw
+} // namespace nfd
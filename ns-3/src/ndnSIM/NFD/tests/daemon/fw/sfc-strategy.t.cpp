@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/sfc-strategy.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+#include "strategy-tester.hpp"
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_AUTO_TEST_SUITE(Fw)
+
+class SfcStrategyFixture : public UnitTestTimeFixture
+{
+protected:
+  SfcStrategyFixture()
+    : strategy(forwarder)
+    , fib(forwarder.getFib())
+    , pit(forwarder.getPit())
+    , face1(make_shared<DummyFace>())
+    , face2(make_shared<DummyFace>())
+    , face3(make_shared<DummyFace>())
+  {
+    forwarder.addFace(face1);
+    forwarder.addFace(face2);
+    forwarder.addFace(face3);
+
+    fib::Entry& instance = *fib.insert("/F1a").first;
+    instance.addNextHop(*face2, 1);
+    instance.addNextHop(*face3, 2);
+  }
+
+  shared_ptr<pit::Entry>
+  receiveFunctionInterest(const Name& name, uint32_t nonce)
+  {
+    shared_ptr<Interest> interest = makeInterest(name, nonce);
+    interest->setFunction("/F1a");
+    shared_ptr<pit::Entry> pitEntry = pit.insert(*interest).first;
+    pitEntry->insertOrUpdateInRecord(*face1, *interest);
+    strategy.afterReceiveFunctionInterest(*face1, *interest, *fib.findExactMatch("/F1a"), pitEntry);
+    return pitEntry;
+  }
+
+public:
+  Forwarder forwarder;
+  StrategyTester<fw::SfcStrategy> strategy;
+  Fib& fib;
+  Pit& pit;
+
+  shared_ptr<DummyFace> face1;
+  shared_ptr<DummyFace> face2;
+  shared_ptr<DummyFace> face3;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestSfcStrategy, SfcStrategyFixture)
+
+BOOST_AUTO_TEST_CASE(CostPlusLoad)
+{
+  shared_ptr<pit::Entry> pitEntry1 = this->receiveFunctionInterest("/P/1", 1);
+  shared_ptr<pit::Entry> pitEntry2 = this->receiveFunctionInterest("/P/2", 2);
+  shared_ptr<pit::Entry> pitEntry3 = this->receiveFunctionInterest("/P/3", 3);
+
+  // face2 scores 1 then 2, which ties with idle face3 and wins on cost; then face3 is cheaper
+  BOOST_REQUIRE_EQUAL(strategy.sendInterestHistory.size(), 3);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory[0].outFaceId, face2->getId());
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory[1].outFaceId, face2->getId());
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory[2].outFaceId, face3->getId());
+  BOOST_CHECK_EQUAL(strategy.getLoad(*face2), 2);
+  BOOST_CHECK_EQUAL(strategy.getLoad(*face3), 1);
+
+  strategy.beforeSatisfyInterest(pitEntry1, *face2, *makeData("/P/1"));
+  BOOST_CHECK_EQUAL(strategy.getLoad(*face2), 1);
+
+  pit.erase(pitEntry3.get());
+  pitEntry3.reset();
+  BOOST_CHECK_EQUAL(strategy.getLoad(*face3), 0);
+}
+
+BOOST_AUTO_TEST_CASE(NackFallback)
+{
+  shared_ptr<pit::Entry> pitEntry = this->receiveFunctionInterest("/P/1", 1);
+  BOOST_REQUIRE_EQUAL(strategy.sendInterestHistory.size(), 1);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory[0].outFaceId, face2->getId());
+
+  lp::Nack nack2 = makeNack("/P/1", 1, lp::NackReason::CONGESTION);
+  pitEntry->getOutRecord(*face2)->setIncomingNack(nack2);
+  strategy.afterReceiveNack(*face2, nack2, pitEntry);
+
+  BOOST_REQUIRE_EQUAL(strategy.sendInterestHistory.size(), 2);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory[1].outFaceId, face3->getId());
+  BOOST_CHECK_EQUAL(strategy.sendNackHistory.size(), 0);
+  BOOST_CHECK_EQUAL(strategy.getLoad(*face2), 0);
+
+  lp::Nack nack3 = makeNack("/P/1", 1, lp::NackReason::NO_ROUTE);
+  pitEntry->getOutRecord(*face3)->setIncomingNack(nack3);
+  strategy.afterReceiveNack(*face3, nack3, pitEntry);
+
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.size(), 2);
+  BOOST_REQUIRE_EQUAL(strategy.sendNackHistory.size(), 1);
+  BOOST_CHECK_EQUAL(strategy.sendNackHistory[0].outFaceId, face1->getId());
+  BOOST_CHECK_EQUAL(strategy.sendNackHistory[0].header.getReason(), lp::NackReason::CONGESTION);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestSfcStrategy
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
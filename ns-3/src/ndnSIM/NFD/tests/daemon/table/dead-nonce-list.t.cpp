@@ -114,7 +114,7 @@ BOOST_FIXTURE_TEST_CASE(Lifetime, PeriodicalInsertionFixture)
 {
   BOOST_CHECK_EQUAL(dnl.getLifetime(), LIFETIME);
 
-  const int RATE = DeadNonceList::INITIAL_CAPACITY / 2;
+  const int RATE = DeadNonceList::DEFAULT_CAPACITY / 64;
   this->setRate(RATE);
   this->advanceClocksByLifetime(10.0);
 
@@ -131,28 +131,24 @@ BOOST_FIXTURE_TEST_CASE(Lifetime, PeriodicalInsertionFixture)
   BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), false);
 }
 
-BOOST_FIXTURE_TEST_CASE(CapacityDown, PeriodicalInsertionFixture)
+BOOST_AUTO_TEST_CASE(Capacity)
 {
-  ssize_t cap0 = dnl.m_capacity;
+  Name name("ndn:/N");
 
-  const int RATE = DeadNonceList::INITIAL_CAPACITY / 3;
-  this->setRate(RATE);
-  this->advanceClocksByLifetime(10.0);
-
-  ssize_t cap1 = dnl.m_capacity;
-  BOOST_CHECK_LT(std::abs(cap1 - RATE), std::abs(cap0 - RATE));
-}
-
-BOOST_FIXTURE_TEST_CASE(CapacityUp, PeriodicalInsertionFixture)
-{
-  ssize_t cap0 = dnl.m_capacity;
+  DeadNonceList dnl(DeadNonceList::DEFAULT_LIFETIME, 12);
+  BOOST_CHECK_EQUAL(dnl.getCapacity(), 16); // rounded up to a power of two
 
-  const int RATE = DeadNonceList::INITIAL_CAPACITY * 3;
-  this->setRate(RATE);
-  this->advanceClocksByLifetime(10.0);
+  for (uint32_t nonce = 1; nonce <= 40; ++nonce) {
+    dnl.add(name, nonce);
+  }
+  BOOST_CHECK_EQUAL(dnl.size(), 16);
 
-  ssize_t cap1 = dnl.m_capacity;
-  BOOST_CHECK_LT(std::abs(cap1 - RATE), std::abs(cap0 - RATE));
+  // newest Nonces are kept, oldest are evicted
+  for (uint32_t nonce = 25; nonce <= 40; ++nonce) {
+    BOOST_CHECK_EQUAL(dnl.has(name, nonce), true);
+  }
+  BOOST_CHECK_EQUAL(dnl.has(name, 1), false);
+  BOOST_CHECK_EQUAL(dnl.has(name, 2), false);
 }
 
 BOOST_AUTO_TEST_SUITE_END() // TestDeadNonceList
@@ -24,6 +24,7 @@
  */
 
 #include "table/strategy-choice.hpp"
+#include "fw/multicast-strategy.hpp"
 
 #include "tests/test-common.hpp"
 #include "../fw/dummy-strategy.hpp"
@@ -143,6 +144,36 @@ BOOST_AUTO_TEST_CASE(FindEffectiveStrategyWithPitEntry)
   BOOST_CHECK_EQUAL(table.findEffectiveStrategy(*pitFull).getName(), nameQ);
 }
 
+BOOST_AUTO_TEST_CASE(FindEffectiveStrategyCacheInvalidation)
+{
+  Forwarder forwarder;
+  Name nameP("ndn:/strategy/P");
+  Name nameQ("ndn:/strategy/Q");
+  install<DummyStrategy>(forwarder, nameP);
+  install<DummyStrategy>(forwarder, nameQ);
+
+  StrategyChoice& table = forwarder.getStrategyChoice();
+
+  BOOST_CHECK(table.insert("/A", nameP));
+
+  Pit& pit = forwarder.getPit();
+  shared_ptr<Interest> interestABC = makeInterest("/A/B/C");
+  shared_ptr<pit::Entry> pitABC = pit.insert(*interestABC).first;
+  Measurements& measurements = forwarder.getMeasurements();
+  measurements::Entry& mAB = measurements.get("/A/B");
+
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy(*pitABC).getName(), nameP);
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy(mAB).getName(), nameP);
+
+  BOOST_CHECK(table.insert("/A/B", nameQ));
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy(*pitABC).getName(), nameQ);
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy(mAB).getName(), nameQ);
+
+  table.erase("/A/B");
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy(*pitABC).getName(), nameP);
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy(mAB).getName(), nameP);
+}
+
 BOOST_AUTO_TEST_CASE(FindEffectiveStrategyWithMeasurementsEntry)
 {
   Forwarder forwarder;
@@ -347,6 +378,31 @@ BOOST_AUTO_TEST_CASE(Versioning)
   BOOST_CHECK_EQUAL(table.findEffectiveStrategy("ndn:/").getName(), name4);
 }
 
+BOOST_AUTO_TEST_CASE(OnDemandInstallation)
+{
+  Forwarder forwarder;
+  StrategyChoice& table = forwarder.getStrategyChoice();
+  const Name& multicastName = fw::MulticastStrategy::STRATEGY_NAME;
+  Name multicastUnversioned = multicastName.getPrefix(-1);
+
+  // registered strategies are available, but not instantiated until chosen
+  BOOST_CHECK_EQUAL(table.hasStrategy(multicastName, true), true);
+  BOOST_CHECK_EQUAL(table.hasStrategy(multicastUnversioned, false), true);
+  BOOST_CHECK_EQUAL(table.hasStrategy(multicastUnversioned, true), false);
+  BOOST_CHECK_EQUAL(table.hasStrategy("/localhost/nfd/strategy/unregistered", false), false);
+
+  BOOST_CHECK(table.insert("/A", multicastUnversioned));
+  Strategy& instance = table.findEffectiveStrategy("/A");
+  BOOST_CHECK_EQUAL(instance.getName(), multicastName);
+  BOOST_CHECK(dynamic_cast<fw::MulticastStrategy*>(&instance) != nullptr);
+
+  // later choices reuse the same instance
+  BOOST_CHECK(table.insert("/B", multicastName));
+  BOOST_CHECK_EQUAL(&table.findEffectiveStrategy("/B"), &instance);
+
+  BOOST_CHECK(!table.insert("/C", "/localhost/nfd/strategy/unregistered"));
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestStrategyChoice
 BOOST_AUTO_TEST_SUITE_END() // Table
 
@@ -26,6 +26,9 @@
 #include "ns3/string.h"
 #include "ns3/uinteger.h"
 #include "ns3/double.h"
+#include "ns3/boolean.h"
+
+#include <ndn-cxx/lp/tags.hpp>
 
 NS_LOG_COMPONENT_DEFINE("ndn.ConsumerWindow");
 
@@ -71,6 +74,17 @@ ConsumerWindow::GetTypeId(void)
                     MakeBooleanAccessor(&ConsumerWindow::m_setInitialWindowOnTimeout),
                     MakeBooleanChecker())
 
+      .AddAttribute("ReactToCongestionMarks",
+                    "If true, congestion marks on Data shrink the window (AIMD)",
+                    BooleanValue(false),
+                    MakeBooleanAccessor(&ConsumerWindow::m_reactToCongestionMarks),
+                    MakeBooleanChecker())
+
+      .AddAttribute("Beta", "Multiplicative decrease factor applied on a congestion mark",
+                    DoubleValue(0.5),
+                    MakeDoubleAccessor(&ConsumerWindow::m_beta),
+                    MakeDoubleChecker<double>(0.0, 1.0))
+
       .AddTraceSource("WindowTrace",
                       "Window that controls how many outstanding interests are allowed",
                       MakeTraceSourceAccessor(&ConsumerWindow::m_window),
@@ -84,6 +98,9 @@ ConsumerWindow::GetTypeId(void)
 
 ConsumerWindow::ConsumerWindow()
   : m_payloadSize(1040)
+  , m_ssthresh(std::numeric_limits<double>::max())
+  , m_windowIncrement(0.0)
+  , m_recoveryPoint(0)
   , m_inFlight(0)
 {
 }
@@ -186,7 +203,14 @@ ConsumerWindow::OnData(shared_ptr<const Data> contentObject)
 {
   Consumer::OnData(contentObject);
 
-  m_window = m_window + 1;
+  uint32_t sequenceNumber = contentObject->getName().at(-1).toSequenceNumber();
+  shared_ptr<lp::CongestionMarkTag> congestionMark = contentObject->getTag<lp::CongestionMarkTag>();
+  if (m_reactToCongestionMarks && congestionMark != nullptr && *congestionMark > 0) {
+    WindowDecrease(sequenceNumber);
+  }
+  else {
+    WindowIncrease();
+  }
 
   if (m_inFlight > static_cast<uint32_t>(0))
     m_inFlight--;
@@ -195,6 +219,36 @@ ConsumerWindow::OnData(shared_ptr<const Data> contentObject)
   ScheduleNextPacket();
 }
 
+void
+ConsumerWindow::WindowIncrease()
+{
+  if (m_window.Get() < m_ssthresh) {
+    m_window = m_window + 1;
+    return;
+  }
+
+  m_windowIncrement += 1.0 / m_window.Get();
+  if (m_windowIncrement >= 1.0) {
+    m_window = m_window + 1;
+    m_windowIncrement -= 1.0;
+  }
+}
+
+void
+ConsumerWindow::WindowDecrease(uint32_t sequenceNumber)
+{
+  if (sequenceNumber < m_recoveryPoint) {
+    NS_LOG_DEBUG("Congestion mark on " << sequenceNumber << " ignored, window already reduced");
+    return;
+  }
+
+  m_recoveryPoint = m_seq;
+  m_ssthresh = std::max(1.0, m_window.Get() * m_beta);
+  m_window = static_cast<uint32_t>(m_ssthresh);
+  m_windowIncrement = 0.0;
+  NS_LOG_DEBUG("Congestion mark on " << sequenceNumber << ", window reduced to " << m_window);
+}
+
 void
 ConsumerWindow::OnTimeout(uint32_t sequenceNumber)
 {
@@ -67,6 +67,24 @@ protected:
   virtual void
   ScheduleNextPacket();
 
+  /**
+   * \brief Grow the window after a Data without congestion mark
+   *
+   * The window grows by one per Data below the slow-start threshold,
+   * and by one per window of Data above it.
+   */
+  void
+  WindowIncrease();
+
+  /**
+   * \brief Shrink the window multiplicatively after a Data with congestion mark
+   *
+   * The window is reduced at most once per round trip: marks on Data for Interests
+   * sent before the previous reduction are ignored.
+   */
+  void
+  WindowDecrease(uint32_t sequenceNumber);
+
 private:
   virtual void
   SetWindow(uint32_t window);
@@ -99,6 +117,12 @@ private:
   uint32_t m_initialWindow;
   bool m_setInitialWindowOnTimeout;
 
+  bool m_reactToCongestionMarks;
+  double m_beta;              // multiplicative decrease factor
+  double m_ssthresh;          // slow-start threshold
+  double m_windowIncrement;   // fraction of a window accumulated in congestion avoidance
+  uint32_t m_recoveryPoint;   // first sequence number sent after the last decrease
+
   TracedValue<uint32_t> m_window;
   TracedValue<uint32_t> m_inFlight;
 };
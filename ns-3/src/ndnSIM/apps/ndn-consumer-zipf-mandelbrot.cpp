@@ -167,9 +167,6 @@ ConsumerZipfMandelbrot::SendPacket()
 
   // std::cout << Simulator::Now ().ToDouble (Time::S) << "s -> " << seq << "\n";
 
-  //
-  shared_ptr<Name> nameWithSequence = make_shared<Name>(m_interestName);
-  nameWithSequence->appendSequenceNumber(seq);
   //
   // bykonomu ここから
   ns3::increaseTotalSend();
@@ -192,29 +189,7 @@ ConsumerZipfMandelbrot::SendPacket()
 
   //ここまで追加
 
-  shared_ptr<Interest> interest = make_shared<Interest>();
-  interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-  interest->setName(*nameWithSequence);
-  //std::cout << "Function Type" << functionType << std::endl;
-  //std::cout << "Consumer Function Name" << *functionName << std::endl;
-
-  //ここから
-  interest->setFunction(*functionName);
-	if(getChoiceType() == 2){
-		std::string headFunc = functionName->toUri();
-		int pos = headFunc.find("/",1);
-		headFunc.erase(pos, headFunc.size()-1);
-		Name headFuncName(headFunc);
-		shared_ptr<Name> headFuncNamePtr = make_shared<Name>(headFuncName);
-		interest->setFunctionFullName(*headFuncNamePtr);
-	}
-
-  time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
-	//time::milliseconds interestLifeTime(1000);
-	//interest->setInterestLifetime(interestLifeTime);
-	time::milliseconds nowTime = time::toUnixTimestamp(time::system_clock::now());
-	interest->setServiceTime(nowTime);
-	interest->setFunctionFlag(0);
+  shared_ptr<Interest> interest = MakeInterest(seq, *functionName);
 
   //ここまで
 
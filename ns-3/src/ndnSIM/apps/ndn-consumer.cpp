@@ -151,9 +151,31 @@ Consumer::StartApplication() // Called at time specified by Start
 	// do base stuff
 	App::StartApplication();
 
+	m_interestTemplate = Interest(m_interestName);
+	m_interestTemplate.setFunctionFlag(0);
+
 	ScheduleNextPacket();
 }
 
+shared_ptr<Interest>
+Consumer::MakeInterest(uint32_t seq, const Name& function)
+{
+	auto interest = make_shared<Interest>(m_interestTemplate);
+
+	Name nameWithSequence(m_interestTemplate.getName());
+	nameWithSequence.appendSequenceNumber(seq);
+	interest->setName(nameWithSequence);
+	interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
+	interest->setFunction(function);
+	if (getChoiceType() == 2) {
+		// head function of the chain, e.g. /F1a of /F1a/F2b/F3c
+		interest->setFunctionFullName(function.getPrefix(1));
+	}
+	interest->setServiceTime(time::toUnixTimestamp(time::system_clock::now()));
+
+	return interest;
+}
+
 void
 Consumer::StopApplication() // Called at time specified by Stop
 {
@@ -6743,8 +6765,6 @@ Consumer::SendPacket()
 	}
 
 	//
-	shared_ptr<Name> nameWithSequence = make_shared<Name>(m_interestName);
-	nameWithSequence->appendSequenceNumber(seq);
 
 	ns3::increaseTotalSend();
 	//
@@ -6867,39 +6887,7 @@ Consumer::SendPacket()
   std::cout << getTotalFcc(14) << std::endl;
   std::cout << getTotalFcc(15) << std::endl;
 	 */
-	// shared_ptr<Interest> interest = make_shared<Interest> ();
-	shared_ptr<Interest> interest = make_shared<Interest>();
-	
-	interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-	interest->setName(*nameWithSequence);
-	interest->setFunction(*functionName);
-	if(getChoiceType() == 2){
-		std::string headFunc = functionName->toUri();
-		int pos = headFunc.find("/",1);
-		headFunc.erase(pos, headFunc.size()-1);
-		Name headFuncName(headFunc);
-		shared_ptr<Name> headFuncNamePtr = make_shared<Name>(headFuncName);
-		interest->setFunctionFullName(*headFuncNamePtr);
-	}
-	if(getChoiceType() == 4){
-		// std::string headFunc = functionName->toUri();
-		// int pos = headFunc.find("/",1);
-		// headFunc.erase(pos, headFunc.size()-1);
-		// Name headFuncName(headFunc);
-		// shared_ptr<Name> headFuncNamePtr = make_shared<Name>(headFuncName);
-		// interest->setFunctionFullName(*headFuncNamePtr);
-		// std::string FibCon = "";
-		// Name FibConName(FibCon);
-		// shared_ptr<Name> FibConNamePtr = make_shared<Name>(FibConName);
-		// interest->setFunctionFullName(*FibConNamePtr);
-	}
-
-	time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
-	//time::milliseconds interestLifeTime(1000);
-	//interest->setInterestLifetime(interestLifeTime);
-	time::milliseconds nowTime = time::toUnixTimestamp(time::system_clock::now());
-	interest->setServiceTime(nowTime);
-	interest->setFunctionFlag(0);
+	shared_ptr<Interest> interest = MakeInterest(seq, *functionName);
 
 	// NS_LOG_INFO ("Requesting Interest: \n" << *interest);
 	NS_LOG_INFO("> Interest for " << seq);
@@ -114,6 +114,16 @@ protected:
   virtual void
   ScheduleNextPacket() = 0;
 
+  /**
+   * \brief Make the Interest for \p seq that requests \p function
+   *
+   * The Interest is a copy of the app's Interest template, made on start with the fields that
+   * are the same for every Interest; only the sequence number, nonce, function fields and
+   * service time are filled in per Interest.
+   */
+  shared_ptr<Interest>
+  MakeInterest(uint32_t seq, const Name& function);
+
   /**
    * \brief Checks if the packet need to be retransmitted becuase of retransmission timer expiration
    */
@@ -170,6 +180,7 @@ protected:
   Time m_offTime;          ///< \brief Time interval between packets
   Name m_interestName;     ///< \brief NDN Name of the Interest (use Name)
   Time m_interestLifeTime; ///< \brief LifeTime for interest packet
+  Interest m_interestTemplate; ///< \brief fields shared by all Interests of the app
   int table[2][6][3];
 
   /// @cond include_hidden
@@ -27,6 +27,7 @@
 #include "model/ndn-l3-protocol.hpp"
 #include "helper/ndn-fib-helper.hpp"
 
+#include <map>
 #include <memory>
 #include <ndn-cxx/lp/tags.hpp>
 
@@ -81,6 +82,20 @@ Producer::StartApplication()
   App::StartApplication();
 
   FibHelper::AddRoute(GetNode(), m_prefix, m_face, 0);
+
+  // the fake signature is the same for every Data, and is built once
+  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+
+  if (m_keyLocator.size() > 0) {
+    signatureInfo.setKeyLocator(m_keyLocator);
+  }
+
+  m_fakeSignature = Signature();
+  m_fakeSignature.setInfo(signatureInfo);
+  m_fakeSignature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue,
+                                                              m_signature));
+  // encodes SignatureInfo, so that the copy in each Data carries its wire encoding
+  m_fakeSignature.getInfo();
 }
 
 void
@@ -145,20 +160,8 @@ Producer::OnInterest(shared_ptr<const Interest> interest)
   data->setServiceTime(interest->getServiceTime());
    //std::cout << "Producer servicetime: " << data->getServiceTime().count() << std::endl;
 
-  data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
-
-
-  Signature signature;
-  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
-
-  if (m_keyLocator.size() > 0) {
-    signatureInfo.setKeyLocator(m_keyLocator);
-  }
-
-  signature.setInfo(signatureInfo);
-  signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
-
-  data->setSignature(signature);
+  data->setContent(GetVirtualPayload(m_virtualPayloadSize));
+  data->setSignature(m_fakeSignature);
 
   NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
 
@@ -169,5 +172,17 @@ Producer::OnInterest(shared_ptr<const Interest> interest)
   m_appLink->onReceiveData(*data);
 }
 
+shared_ptr<const ::ndn::Buffer>
+Producer::GetVirtualPayload(uint32_t size)
+{
+  static std::map<uint32_t, shared_ptr<const ::ndn::Buffer>> payloads;
+
+  shared_ptr<const ::ndn::Buffer>& payload = payloads[size];
+  if (payload == nullptr) {
+    payload = make_shared< ::ndn::Buffer>(size);
+  }
+  return payload;
+}
+
 } // namespace ndn
 } // namespace ns3
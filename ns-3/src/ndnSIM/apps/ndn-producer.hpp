@@ -59,6 +59,16 @@ protected:
   virtual void
   StopApplication(); // Called at time specified by Stop
 
+private:
+  /**
+   * \brief Get a zero-filled payload of \p size bytes
+   *
+   * Virtual payloads are never modified, so all producers share one read-only buffer per size
+   * and Data packets refer to it instead of allocating their own.
+   */
+  static shared_ptr<const ::ndn::Buffer>
+  GetVirtualPayload(uint32_t size);
+
 private:
   Name m_prefix;
   Name m_postfix;
@@ -67,6 +77,8 @@ private:
 
   uint32_t m_signature;
   Name m_keyLocator;
+
+  Signature m_fakeSignature; ///< \brief built from Signature and KeyLocator on start
 };
 
 } // namespace ndn
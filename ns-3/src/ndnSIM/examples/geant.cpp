@@ -83,7 +83,7 @@ main(int argc, char* argv[])
 	//On Cache by konomu
 	if(cachetype == "onCache"){
 		ndn::StackHelper ndnHelper1;
-		ndnHelper1.SetOldContentStore("ns3::ndn::cs::Lru", "MaxSize",
+		ndnHelper1.SetOldContentStore("ns3::ndn::cs::Latency", "MaxSize",
 									"10"); // default ContentStore parameters
 		ndnHelper1.Install(Names::Find<Node>("Node1"));
 		ndnHelper1.Install(Names::Find<Node>("Node2"));
@@ -38,6 +38,7 @@
 #include "ns3/ndnSIM/NFD/daemon/face/generic-link-service.hpp"
 #include "ns3/ndnSIM/NFD/daemon/table/cs-policy-priority-fifo.hpp"
 #include "ns3/ndnSIM/NFD/daemon/table/cs-policy-lru.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/cs-admission-policy.hpp"
 
 NS_LOG_COMPONENT_DEFINE("ndn.StackHelper");
 
@@ -49,8 +50,15 @@ StackHelper::StackHelper()
   // , m_isFaceManagerDisabled(false)
   , m_isForwarderStatusManagerDisabled(false)
   , m_isStrategyChoiceManagerDisabled(false)
+  , m_isLoopDetectionEnabled(false)
+  , m_isMeasuredInstanceSelectionEnabled(false)
+  , m_isInterestBatchingEnabled(false)
+  , m_isCacheHitFastPathEnabled(false)
+  , m_isCongestionMarkingEnabled(false)
+  , m_isLinkBundlingEnabled(false)
   , m_needSetDefaultRoutes(false)
   , m_maxCsSize(100)
+  , m_isOldCsPolicySelected(false)
 {
   setCustomNdnCxxClocks();
 
@@ -59,6 +67,10 @@ StackHelper::StackHelper()
 
   m_csPolicyCreationFunc = m_csPolicies["nfd::cs::lru"];
 
+  m_oldCsPolicies.insert({"ndnSIM::cs::latency", "ns3::ndn::cs::Latency"});
+  m_oldCsPolicies.insert({"ndnSIM::cs::latency_recency", "ns3::ndn::cs::LatencyRecency"});
+  m_oldCsPolicies.insert({"ndnSIM::cs::function_aware", "ns3::ndn::cs::FunctionAware"});
+
   m_ndnFactory.SetTypeId("ns3::ndn::L3Protocol");
   m_contentStoreFactory.SetTypeId("ns3::ndn::cs::Lru");
 
@@ -129,6 +141,36 @@ StackHelper::SetOldContentStore(const std::string& contentStore, const std::stri
     m_contentStoreFactory.Set(attr4, StringValue(value4));
 }
 
+void
+StackHelper::setCsAdmissionPolicy(const std::string& policy,
+                                  const std::string& option1, const std::string& value1,
+                                  const std::string& option2, const std::string& value2,
+                                  const std::string& option3, const std::string& value3)
+{
+  m_csAdmission.clear();
+  m_csAdmission["policy"] = policy;
+  if (option1 != "")
+    m_csAdmission[option1] = value1;
+  if (option2 != "")
+    m_csAdmission[option2] = value2;
+  if (option3 != "")
+    m_csAdmission[option3] = value3;
+
+  // validate now rather than when the first node is installed
+  nfd::ConfigSection section;
+  for (const auto& option : m_csAdmission) {
+    section.put(option.first, option.second);
+  }
+  try {
+    if (nfd::fw::CsAdmissionPolicy::create(policy, section) == nullptr) {
+      NS_FATAL_ERROR("Cache admission policy " << policy << " not found");
+    }
+  }
+  catch (const nfd::ConfigFile::Error& e) {
+    NS_FATAL_ERROR("Invalid option of cache admission policy " << policy << ": " << e.what());
+  }
+}
+
 void
 StackHelper::setCsSize(size_t maxSize)
 {
@@ -139,8 +181,14 @@ void
 StackHelper::setPolicy(const std::string& policy)
 {
   auto found = m_csPolicies.find(policy);
+  auto foundOld = m_oldCsPolicies.find(policy);
   if (found != m_csPolicies.end()) {
     m_csPolicyCreationFunc = found->second;
+    m_isOldCsPolicySelected = false;
+  }
+  else if (foundOld != m_oldCsPolicies.end()) {
+    m_contentStoreFactory.SetTypeId(foundOld->second);
+    m_isOldCsPolicySelected = true;
   }
   else {
     NS_FATAL_ERROR("Cache replacement policy " << policy << " not found");
@@ -148,6 +196,9 @@ StackHelper::setPolicy(const std::string& policy)
     for (auto it = m_csPolicies.begin(); it != m_csPolicies.end(); it++) {
       NS_LOG_DEBUG("    " << it->first);
     }
+    for (auto it = m_oldCsPolicies.begin(); it != m_oldCsPolicies.end(); it++) {
+      NS_LOG_DEBUG("    " << it->first);
+    }
   }
 }
 
@@ -196,12 +247,38 @@ StackHelper::Install(Ptr<Node> node) const
     ndn->getConfig().put("ndnSIM.disable_strategy_choice_manager", true);
   }
 
+  if (m_isLoopDetectionEnabled) {
+    ndn->getConfig().put("ndnSIM.enable_loop_detection", true);
+  }
+
+  if (m_isMeasuredInstanceSelectionEnabled) {
+    ndn->getConfig().put("ndnSIM.enable_measured_instance_selection", true);
+  }
+
+  if (m_isInterestBatchingEnabled) {
+    ndn->getConfig().put("ndnSIM.enable_interest_batching", true);
+  }
+
+  if (m_isCacheHitFastPathEnabled) {
+    ndn->getConfig().put("ndnSIM.enable_cache_hit_fast_path", true);
+  }
+
   ndn->getConfig().put("tables.cs_max_packets", (m_maxCsSize == 0) ? 1 : m_maxCsSize);
 
+  for (const auto& option : m_csAdmission) {
+    ndn->getConfig().put("tables.cs_admission." + option.first, option.second);
+  }
+
   // Create and aggregate content store if NFD's contest store has been disabled
   if (m_maxCsSize == 0) {
     ndn->AggregateObject(m_contentStoreFactory.Create<ContentStore>());
   }
+  // ndnSIM content store selected with setPolicy, sized with setCsSize
+  else if (m_isOldCsPolicySelected) {
+    ObjectFactory contentStoreFactory = m_contentStoreFactory;
+    contentStoreFactory.Set("MaxSize", StringValue(std::to_string(m_maxCsSize)));
+    ndn->AggregateObject(contentStoreFactory.Create<ContentStore>());
+  }
   // if NFD's CS is enabled, check if a replacement policy has been specified
   else {
     ndn->setCsReplacementPolicy(m_csPolicyCreationFunc);
@@ -274,6 +351,7 @@ StackHelper::DefaultNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn,
   ::nfd::face::GenericLinkService::Options opts;
   opts.allowFragmentation = true;
   opts.allowReassembly = true;
+  opts.allowBundling = m_isLinkBundlingEnabled;
 
   auto linkService = make_unique<::nfd::face::GenericLinkService>(opts);
 
@@ -312,6 +390,16 @@ StackHelper::PointToPointNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn,
   ::nfd::face::GenericLinkService::Options opts;
   opts.allowFragmentation = true;
   opts.allowReassembly = true;
+  opts.allowBundling = m_isLinkBundlingEnabled;
+  opts.allowCongestionMarking = m_isCongestionMarkingEnabled;
+  if (m_isCongestionMarkingEnabled) {
+    // bytes that take the CoDel target delay to drain, but at least one full-size packet
+    const Time congestionTarget = MilliSeconds(5);
+    DataRateValue dataRate;
+    netDevice->GetAttribute("DataRate", dataRate);
+    uint64_t targetBytes = dataRate.Get().GetBitRate() * congestionTarget.GetSeconds() / 8;
+    opts.defaultCongestionThreshold = std::max<uint64_t>(targetBytes, netDevice->GetMtu());
+  }
 
   auto linkService = make_unique<::nfd::face::GenericLinkService>(opts);
 
@@ -426,5 +514,41 @@ StackHelper::disableForwarderStatusManager()
   m_isForwarderStatusManagerDisabled = true;
 }
 
+void
+StackHelper::setLoopDetection(bool isEnabled)
+{
+  m_isLoopDetectionEnabled = isEnabled;
+}
+
+void
+StackHelper::setMeasuredInstanceSelection(bool isEnabled)
+{
+  m_isMeasuredInstanceSelectionEnabled = isEnabled;
+}
+
+void
+StackHelper::setInterestBatching(bool isEnabled)
+{
+  m_isInterestBatchingEnabled = isEnabled;
+}
+
+void
+StackHelper::setCacheHitFastPath(bool isEnabled)
+{
+  m_isCacheHitFastPathEnabled = isEnabled;
+}
+
+void
+StackHelper::setCongestionMarking(bool isEnabled)
+{
+  m_isCongestionMarkingEnabled = isEnabled;
+}
+
+void
+StackHelper::setLinkBundling(bool isEnabled)
+{
+  m_isLinkBundlingEnabled = isEnabled;
+}
+
 } // namespace ndn
 } // namespace ns3
@@ -82,10 +82,31 @@ public:
 
   /**
    * @brief Set the cache replacement policy for NFD's Content Store
+   *
+   * Besides NFD policies ("nfd::cs::lru", "nfd::cs::priority_fifo"), the ndnSIM policies
+   * "ndnSIM::cs::latency", "ndnSIM::cs::latency_recency" and "ndnSIM::cs::function_aware"
+   * can be selected.  These replace NFD's Content Store with the ndnSIM content store using
+   * that policy, whose size is set by setCsSize.
    */
   void
   setPolicy(const std::string& policy);
 
+  /**
+   * @brief Set the policy deciding whether Data that satisfied pending Interests is cached
+   *
+   * Policies are "admit-all" (default), "probabilistic" (option "probability"),
+   * "tinylfu" (options "threshold", "width", "sample_size") and "sfc", which caches only
+   * on function instance nodes and nodes where the producer or consumer is attached
+   * (option "function_node" set to "yes" when installing on function instance nodes,
+   * option "admit_transit", probability of caching on other nodes).
+   * The policy applies to nodes installed afterwards, with either content store.
+   */
+  void
+  setCsAdmissionPolicy(const std::string& policy,
+                       const std::string& option1 = "", const std::string& value1 = "",
+                       const std::string& option2 = "", const std::string& value2 = "",
+                       const std::string& option3 = "", const std::string& value3 = "");
+
   /**
    * @brief Set ndnSIM 1.0 content store implementation and its attributes
    * @param contentStoreClass string, representing class of the content store
@@ -248,6 +269,62 @@ public:
   void
   disableForwarderStatusManager();
 
+  /**
+   * \brief Enable or disable Interest loop detection (Dead Nonce List and PIT Nonce checks)
+   *
+   * Loop detection is disabled by default, so that function-chained Interests can revisit nodes.
+   */
+  void
+  setLoopDetection(bool isEnabled);
+
+  /**
+   * \brief Enable or disable function instance selection by measured service time
+   *
+   * When enabled, the fibControl choice type selects the instance with the lowest measured
+   * SRTT and periodically probes the other instances, instead of using FIB cost only.
+   */
+  void
+  setMeasuredInstanceSelection(bool isEnabled);
+
+  /**
+   * \brief Enable or disable batched processing of Interests received at the same time
+   *
+   * When enabled, Interests arriving at a node in the same simulator timestamp are processed
+   * together after their NameTree buckets have been prefetched.  Processing order is unchanged.
+   */
+  void
+  setInterestBatching(bool isEnabled);
+
+  /**
+   * \brief Enable or disable the cache-hit fast path
+   *
+   * When enabled, an Interest without PIT entry is looked up in the content store first, and a
+   * cache hit is answered without creating a PIT entry.  The SatisfiedInterests trace still fires.
+   */
+  void
+  setCacheHitFastPath(bool isEnabled);
+
+  /**
+   * \brief Enable or disable congestion marking on point-to-point faces
+   *
+   * When enabled, a face marks outgoing packets CoDel-style once the transmit queue of its
+   * PointToPointNetDevice has held more than 5ms (the CoDel target) worth of the link data rate
+   * for a marking interval.  Marks are carried back to consumers on Data, where
+   * ns3::ndn::ConsumerWindow reacts to them if its ReactToCongestionMarks attribute is true.
+   */
+  void
+  setCongestionMarking(bool isEnabled);
+
+  /**
+   * \brief Enable or disable link-layer bundling on NetDevice faces
+   *
+   * When enabled, LpPackets sent to a face within 1ms of each other are carried in one
+   * link frame of at most 1400 bytes, which reduces the number of ns-3 packets and
+   * transmission events at high Interest rates.  Bundles are unbundled on receipt.
+   */
+  void
+  setLinkBundling(bool isEnabled);
+
 private:
   shared_ptr<Face>
   DefaultNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<NetDevice> netDevice) const;
@@ -262,6 +339,12 @@ private:
   // bool m_isFaceManagerDisabled;
   bool m_isForwarderStatusManagerDisabled;
   bool m_isStrategyChoiceManagerDisabled;
+  bool m_isLoopDetectionEnabled;
+  bool m_isMeasuredInstanceSelectionEnabled;
+  bool m_isInterestBatchingEnabled;
+  bool m_isCacheHitFastPathEnabled;
+  bool m_isCongestionMarkingEnabled;
+  bool m_isLinkBundlingEnabled;
 
 public:
   void
@@ -279,6 +362,13 @@ private:
 
   std::map<std::string, PolicyCreationCallback> m_csPolicies;
 
+  /// ndnSIM content store TypeId of each ndnSIM policy name accepted by setPolicy
+  std::map<std::string, std::string> m_oldCsPolicies;
+  bool m_isOldCsPolicySelected;
+
+  /// "tables.cs_admission" section of the NFD configuration, empty for the default policy
+  std::map<std::string, std::string> m_csAdmission;
+
   typedef std::list<std::pair<TypeId, FaceCreateCallback>> NetDeviceCallbackList;
   NetDeviceCallbackList m_netDeviceCallbacks;
 };
@@ -23,6 +23,9 @@
 #include "../../utils/trie/lru-policy.hpp"
 #include "../../utils/trie/fifo-policy.hpp"
 #include "../../utils/trie/lfu-policy.hpp"
+#include "../../utils/trie/latency-policy.hpp"
+#include "../../utils/trie/latency-recency-policy.hpp"
+#include "../../utils/trie/function-aware-policy.hpp"
 #include "../../utils/trie/multi-policy.hpp"
 #include "../../utils/trie/aggregate-stats-policy.hpp"
 
@@ -63,10 +66,28 @@ template class ContentStoreImpl<fifo_policy_traits>;
  **/
 template class ContentStoreImpl<lfu_policy_traits>;
 
+/**
+ * @brief ContentStore evicting the entry with the lowest retrieval latency
+ **/
+template class ContentStoreImpl<latency_policy_traits>;
+
+/**
+ * @brief ContentStore evicting by retrieval latency and time of last use (GreedyDual-Size like)
+ **/
+template class ContentStoreImpl<latency_recency_policy_traits>;
+
+/**
+ * @brief ContentStore with LRU cache replacement policy that keeps function results longer
+ **/
+template class ContentStoreImpl<function_aware_policy_traits>;
+
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, lru_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, random_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, fifo_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, lfu_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, latency_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, latency_recency_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, function_aware_policy_traits);
 
 typedef multi_policy_traits<boost::mpl::vector2<lru_policy_traits, aggregate_stats_policy_traits>>
   LruWithCountsTraits;
@@ -114,6 +135,24 @@ class Random : public ContentStoreImpl<random_policy_traits> {
  */
 class Lfu : public ContentStoreImpl<lfu_policy_traits> {
 };
+
+/**
+ * \brief Content Store evicting the entry with the lowest retrieval latency
+ */
+class Latency : public ContentStoreImpl<latency_policy_traits> {
+};
+
+/**
+ * \brief Content Store evicting by retrieval latency and time of last use
+ */
+class LatencyRecency : public ContentStoreImpl<latency_recency_policy_traits> {
+};
+
+/**
+ * \brief Content Store with LRU cache replacement policy that keeps function results longer
+ */
+class FunctionAware : public ContentStoreImpl<function_aware_policy_traits> {
+};
 #endif
 
 } // namespace cs
@@ -53,8 +53,8 @@ public:
   {
   }
 
-  EntryImpl(Ptr<ContentStore> cs, shared_ptr<const Data> data, long long latency, long long currenttime)
-    : Entry(cs, data, latency, currenttime)
+  EntryImpl(Ptr<ContentStore> cs, shared_ptr<const Data> data, time::nanoseconds retrievalCost)
+    : Entry(cs, data, retrievalCost)
     , item_(0)
   {
   }
@@ -108,7 +108,7 @@ public:
 
   // from ContentStore
 
-  virtual inline shared_ptr<Data>
+  virtual inline shared_ptr<const Data>
   Lookup(shared_ptr<const Interest> interest);
 
  virtual inline bool
@@ -116,7 +116,7 @@ public:
 
 
   virtual inline bool
-  Add(shared_ptr<const Data> data, long long latency, long long currenttime);
+  Add(shared_ptr<const Data> data, time::nanoseconds retrievalCost);
 
   // virtual bool
   // Remove (shared_ptr<Interest> header);
@@ -212,7 +212,7 @@ private:
 };
 
 template<class Policy>
-shared_ptr<Data>
+shared_ptr<const Data>
 ContentStoreImpl<Policy>::Lookup(shared_ptr<const Interest> interest)
 {
   NS_LOG_FUNCTION(this << interest->getName());
@@ -231,9 +231,8 @@ ContentStoreImpl<Policy>::Lookup(shared_ptr<const Interest> interest)
   if (node != this->end()) {
     this->m_cacheHitsTrace(interest, node->payload()->GetData());
 
-    shared_ptr<Data> copy = make_shared<Data>(*node->payload()->GetData());
     node->payload()->UpdateCurrentTime(); //update m_time
-    return copy;
+    return node->payload()->GetData();
   }
   else {
     this->m_cacheMissesTrace(interest);
@@ -269,12 +268,11 @@ ContentStoreImpl<Policy>::Add(shared_ptr<const Data> data)
 
 template<class Policy>
 bool
-ContentStoreImpl<Policy>::Add(shared_ptr<const Data> data, long long latency, long long currenttime)
+ContentStoreImpl<Policy>::Add(shared_ptr<const Data> data, time::nanoseconds retrievalCost)
 {
   NS_LOG_FUNCTION(this << data->getName());
 
-  //Ptr<entry> newEntry = Create<entry>(this, data);
-  Ptr<entry> newEntry = Create<entry>(this, data, latency, currenttime);
+  Ptr<entry> newEntry = Create<entry>(this, data, retrievalCost);
   std::pair<typename super::iterator, bool> result = super::insert(data->getName(), newEntry);
 
   if (result.first != super::end()) {
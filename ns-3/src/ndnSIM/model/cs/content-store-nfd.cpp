@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "content-store-nfd.hpp"
+
+#include "ns3/log.h"
+
+#include "ns3/ndnSIM/NFD/daemon/table/cs.hpp"
+
+NS_LOG_COMPONENT_DEFINE("ndn.cs.Nfd");
+
+namespace ns3 {
+namespace ndn {
+namespace cs {
+
+NS_OBJECT_ENSURE_REGISTERED(Nfd);
+
+TypeId
+Nfd::GetTypeId(void)
+{
+  // no constructor is registered: the object is created by NFD's forwarder for its own Cs
+  static TypeId tid = TypeId("ns3::ndn::cs::Nfd")
+                        .SetGroupName("Ndn")
+                        .SetParent<ContentStore>();
+
+  return tid;
+}
+
+Nfd::Nfd(::nfd::cs::Cs* cs)
+  : m_cs(cs)
+{
+}
+
+Nfd::~Nfd()
+{
+}
+
+shared_ptr<const Data>
+Nfd::Lookup(shared_ptr<const Interest> interest)
+{
+  NS_LOG_FUNCTION(this << interest->getName());
+
+  // NFD's Cs invokes one of the callbacks before find returns
+  shared_ptr<const Data> match;
+  m_cs->find(*interest,
+             [&match] (const Interest&, const Data& data) { match = data.shared_from_this(); },
+             [] (const Interest&) {});
+
+  if (match != nullptr) {
+    this->m_cacheHitsTrace(interest, match);
+  }
+  else {
+    this->m_cacheMissesTrace(interest);
+  }
+  return match;
+}
+
+bool
+Nfd::Add(shared_ptr<const Data> data)
+{
+  m_cs->insert(*data);
+  return false;
+}
+
+bool
+Nfd::Add(shared_ptr<const Data> data, time::nanoseconds retrievalCost)
+{
+  m_cs->insert(*data, false, retrievalCost);
+  return false;
+}
+
+bool
+Nfd::AddUnsolicited(shared_ptr<const Data> data)
+{
+  m_cs->insert(*data, true);
+  return false;
+}
+
+void
+Nfd::Print(std::ostream& os) const
+{
+  for (const ::nfd::cs::Entry& entry : *m_cs) {
+    os << entry.getName() << std::endl;
+  }
+}
+
+uint32_t
+Nfd::GetSize() const
+{
+  return m_cs->size();
+}
+
+Ptr<cs::Entry>
+Nfd::Begin()
+{
+  if (m_cs->begin() == m_cs->end()) {
+    return End();
+  }
+  return Create<cs::Entry>(this, m_cs->begin()->getData().shared_from_this());
+}
+
+Ptr<cs::Entry>
+Nfd::End()
+{
+  return 0;
+}
+
+Ptr<cs::Entry>
+Nfd::Next(Ptr<cs::Entry> from)
+{
+  if (from == 0) {
+    return 0;
+  }
+
+  for (auto it = m_cs->begin(); it != m_cs->end(); ++it) {
+    if (&it->getData() != from->GetData().get()) {
+      continue;
+    }
+    if (++it == m_cs->end()) {
+      return End();
+    }
+    return Create<cs::Entry>(this, it->getData().shared_from_this());
+  }
+  return End();
+}
+
+} // namespace cs
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CONTENT_STORE_NFD_H
+#define NDN_CONTENT_STORE_NFD_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
+
+namespace nfd {
+namespace cs {
+class Cs;
+} // namespace cs
+} // namespace nfd
+
+namespace ns3 {
+namespace ndn {
+namespace cs {
+
+/**
+ * @ingroup ndn-cs
+ * @brief ContentStore interface to NFD's content store
+ *
+ * NFD's forwarder accesses its content store only through the ContentStore interface,
+ * whether NFD's Cs or one of ndnSIM's content stores is selected. This class gives the
+ * forwarder, CsTracer and other users of the ContentStore interface access to NFD's Cs.
+ * Its index is NFD's name-ordered table, and its replacement policy is the one set on
+ * NFD's Cs (see StackHelper::setPolicy).
+ */
+class Nfd : public ContentStore {
+public:
+  /**
+   * \brief Interface ID
+   *
+   * \return interface ID
+   */
+  static TypeId
+  GetTypeId();
+
+  /**
+   * @brief Create an interface to @p cs, which must outlive any use of this object
+   */
+  explicit
+  Nfd(::nfd::cs::Cs* cs);
+
+  /**
+   * @brief Virtual destructor
+   */
+  virtual ~Nfd();
+
+  virtual shared_ptr<const Data>
+  Lookup(shared_ptr<const Interest> interest);
+
+  virtual bool
+  Add(shared_ptr<const Data> data);
+
+  virtual bool
+  Add(shared_ptr<const Data> data, time::nanoseconds retrievalCost);
+
+  virtual bool
+  AddUnsolicited(shared_ptr<const Data> data);
+
+  virtual void
+  Print(std::ostream& os) const;
+
+  virtual uint32_t
+  GetSize() const;
+
+  virtual Ptr<cs::Entry>
+  Begin();
+
+  virtual Ptr<cs::Entry>
+  End();
+
+  /**
+   * @brief Advance the iterator
+   *
+   * NFD's Cs has no handle on its entries, so this is linear in the number of entries
+   */
+  virtual Ptr<cs::Entry> Next(Ptr<cs::Entry>);
+
+private:
+  ::nfd::cs::Cs* m_cs;
+};
+
+} // namespace cs
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONTENT_STORE_NFD_H
@@ -49,7 +49,7 @@ Nocache::~Nocache()
 {
 }
 
-shared_ptr<Data>
+shared_ptr<const Data>
 Nocache::Lookup(shared_ptr<const Interest> interest)
 {
   this->m_cacheMissesTrace(interest);
@@ -63,7 +63,7 @@ Nocache::Add(shared_ptr<const Data> data)
 }
 
 bool
-Nocache::Add(shared_ptr<const Data> data, long long latency, long long currenttime)
+Nocache::Add(shared_ptr<const Data> data, time::nanoseconds retrievalCost)
 {
   return false;
 }
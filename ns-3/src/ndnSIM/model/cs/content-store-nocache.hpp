@@ -52,14 +52,14 @@ public:
    */
   virtual ~Nocache();
 
-  virtual shared_ptr<Data>
+  virtual shared_ptr<const Data>
   Lookup(shared_ptr<const Interest> interest);
 
   virtual bool
   Add(shared_ptr<const Data> data);
 
   virtual bool
-  Add(shared_ptr<const Data> data, long long latency, long long currenttime);
+  Add(shared_ptr<const Data> data, time::nanoseconds retrievalCost);
 
   virtual void
   Print(std::ostream& os) const;
@@ -49,6 +49,11 @@ public:
 
   typedef typename super::policy_container::template index<1>::type freshness_policy_container;
 
+  ContentStoreWithFreshness();
+
+  virtual
+  ~ContentStoreWithFreshness();
+
   static TypeId
   GetTypeId();
 
@@ -59,20 +64,31 @@ public:
   Add(shared_ptr<const Data> data);
 
   virtual inline bool
-  Add(shared_ptr<const Data> data, int latency, long long currenttime);
+  Add(shared_ptr<const Data> data, time::nanoseconds retrievalCost);
 
 private:
   inline void
   CleanExpired();
 
   inline void
-  RescheduleCleaning();
+  ScheduleCleaning();
+
+  void
+  SetCleaningInterval(Time interval)
+  {
+    this->getPolicy().template get<freshness_policy_container>().set_granularity(interval);
+  }
+
+  Time
+  GetCleaningInterval() const
+  {
+    return this->getPolicy().template get<freshness_policy_container>().get_granularity();
+  }
 
 private:
   static LogComponent g_log; ///< @brief Logging variable
 
   EventId m_cleanEvent;
-  Time m_scheduledCleaningTime;
 };
 
 //////////////////////////////////////////
@@ -92,12 +108,34 @@ ContentStoreWithFreshness<Policy>::GetTypeId()
                         .SetParent<super>()
                         .template AddConstructor<ContentStoreWithFreshness<Policy>>()
 
+                        .AddAttribute("CleaningInterval",
+                                      "Period of removing stale entries. A stale entry is removed "
+                                      "within this interval after its freshness period ends, and "
+                                      "at most one cleaning event per interval is scheduled",
+                                      TimeValue(MilliSeconds(10)),
+                                      MakeTimeAccessor(&ContentStoreWithFreshness<Policy>::
+                                                         SetCleaningInterval,
+                                                       &ContentStoreWithFreshness<Policy>::
+                                                         GetCleaningInterval),
+                                      MakeTimeChecker(TimeStep(1)))
+
     // trace stuff here
     ;
 
   return tid;
 }
 
+template<class Policy>
+ContentStoreWithFreshness<Policy>::ContentStoreWithFreshness()
+{
+}
+
+template<class Policy>
+ContentStoreWithFreshness<Policy>::~ContentStoreWithFreshness()
+{
+  m_cleanEvent.Cancel();
+}
+
 template<class Policy>
 inline bool
 ContentStoreWithFreshness<Policy>::Add(shared_ptr<const Data> data)
@@ -107,52 +145,42 @@ ContentStoreWithFreshness<Policy>::Add(shared_ptr<const Data> data)
     return false;
 
   NS_LOG_DEBUG(data->getName() << " added to cache");
-  RescheduleCleaning();
+  ScheduleCleaning();
   return true;
 }
 
 template<class Policy>
 inline bool
-ContentStoreWithFreshness<Policy>::Add(shared_ptr<const Data> data, int latency, long long currenttime)
+ContentStoreWithFreshness<Policy>::Add(shared_ptr<const Data> data, time::nanoseconds retrievalCost)
 {
-  bool ok = super::Add(data, latency, currenttime);
+  bool ok = super::Add(data, retrievalCost);
   if (!ok)
     return false;
 
   NS_LOG_DEBUG(data->getName() << " added to cache");
-  RescheduleCleaning();
+  ScheduleCleaning();
   return true;
 }
 
 template<class Policy>
 inline void
-ContentStoreWithFreshness<Policy>::RescheduleCleaning()
+ContentStoreWithFreshness<Policy>::ScheduleCleaning()
 {
+  // entries are expired in bulk at the end of each cleaning interval, so inserting an entry
+  // does not need to reschedule the event, whatever its freshness period is
+  if (m_cleanEvent.IsRunning()) {
+    return;
+  }
+
   const freshness_policy_container& freshness =
     this->getPolicy().template get<freshness_policy_container>();
-
-  if (freshness.size() > 0) {
-    Time nextStateTime =
-      freshness_policy_container::policy_base::get_freshness(&(*freshness.begin()));
-
-    if (m_scheduledCleaningTime.IsZero() ||      // if not yet scheduled
-        m_scheduledCleaningTime > nextStateTime) // if new item expire sooner than already scheduled
-    {
-      if (m_cleanEvent.IsRunning()) {
-        Simulator::Remove(m_cleanEvent); // just canceling would not clean up list of events
-      }
-
-      // NS_LOG_DEBUG ("Next event in: " << (nextStateTime - Now ()).ToDouble (Time::S) << "s");
-      m_cleanEvent = Simulator::Schedule(nextStateTime - Now(),
-                                         &ContentStoreWithFreshness<Policy>::CleanExpired, this);
-      m_scheduledCleaningTime = nextStateTime;
-    }
-  }
-  else {
-    if (m_cleanEvent.IsRunning()) {
-      Simulator::Remove(m_cleanEvent); // just canceling would not clean up list of events
-    }
+  if (freshness.empty()) {
+    return;
   }
+
+  Time now = Simulator::Now();
+  m_cleanEvent = Simulator::Schedule(freshness.get_slot_end(now) - now,
+                                     &ContentStoreWithFreshness<Policy>::CleanExpired, this);
 }
 
 template<class Policy>
@@ -162,26 +190,13 @@ ContentStoreWithFreshness<Policy>::CleanExpired()
   freshness_policy_container& freshness =
     this->getPolicy().template get<freshness_policy_container>();
 
-  // NS_LOG_LOGIC (">> Cleaning: Total number of items:" << this->getPolicy ().size () << ", items
-  // with freshness: " << freshness.size ());
-  Time now = Simulator::Now();
-
-  while (!freshness.empty()) {
-    typename freshness_policy_container::iterator entry = freshness.begin();
-
-    if (freshness_policy_container::policy_base::get_freshness(&(*entry))
-        <= now) // is the record stale?
-    {
-      super::erase(&(*entry));
-    }
-    else
-      break; // nothing else to do. All later records will not be stale
-  }
-  // NS_LOG_LOGIC ("<< Cleaning: Total number of items:" << this->getPolicy ().size () << ", items
-  // with freshness: " << freshness.size ());
+  NS_LOG_LOGIC(">> Cleaning: items with freshness: " << freshness.size());
+  freshness.expire(Simulator::Now(), [this] (typename super::iterator item) {
+      super::erase(item);
+    });
+  NS_LOG_LOGIC("<< Cleaning: items with freshness: " << freshness.size());
 
-  m_scheduledCleaningTime = Time();
-  RescheduleCleaning();
+  ScheduleCleaning();
 }
 
 template<class Policy>
@@ -27,6 +27,9 @@
 #include <boost/intrusive/options.hpp>
 #include <boost/intrusive/list.hpp>
 
+#include <algorithm>
+#include <vector>
+
 #include <ns3/nstime.h>
 #include <ns3/simulator.h>
 #include <ns3/traced-callback.h>
@@ -37,6 +40,11 @@ namespace ndnSIM {
 
 /**
  * @brief Traits for freshness policy
+ *
+ * Entries with a positive FreshnessPeriod are kept in a hashed timing wheel: the time line is
+ * divided into slots of a fixed granularity, and an entry is linked into the slot in which it
+ * expires. Insertion and removal are O(1), and expiration is done for all entries of a slot at
+ * once by expire(), which is meant to be called once per granularity interval.
  */
 struct freshness_policy_traits {
   /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
@@ -46,7 +54,10 @@ struct freshness_policy_traits {
     return "Freshness";
   }
 
-  struct policy_hook_type : public boost::intrusive::set_member_hook<> {
+  /// @brief number of slots in the timing wheel
+  static const size_t WHEEL_SIZE = 1024;
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> {
     Time timeWhenShouldExpire;
   };
 
@@ -72,20 +83,10 @@ struct freshness_policy_traits {
                policy_container::value_traits::to_node_ptr(*item))->timeWhenShouldExpire;
     }
 
-    template<class Key>
-    struct MemberHookLess {
-      bool
-      operator()(const Key& a, const Key& b) const
-      {
-        return get_freshness(&a) < get_freshness(&b);
-      }
-    };
-
-    typedef boost::intrusive::multiset<Container,
-                                       boost::intrusive::compare<MemberHookLess<Container>>,
-                                       Hook> policy_container;
+    /// @brief entries expiring within one slot of the timing wheel
+    typedef boost::intrusive::list<Container, Hook> policy_container;
 
-    class type : public policy_container {
+    class type {
     public:
       typedef policy policy_base; // to get access to get_freshness methods from outside
       typedef Container parent_trie;
@@ -93,6 +94,10 @@ struct freshness_policy_traits {
       type(Base& base)
         : base_(base)
         , max_size_(100)
+        , wheel_(WHEEL_SIZE)
+        , granularity_(MilliSeconds(10))
+        , nextSlot_(0)
+        , size_(0)
       {
       }
 
@@ -113,7 +118,8 @@ struct freshness_policy_traits {
           // controlled by the policy.
           // Note that .size() on this policy would return only the number of items with
           // non-infinite freshness policy
-          policy_container::insert(*item);
+          get_wheel_slot(get_freshness(item)).push_back(*item);
+          ++size_;
         }
 
         return true;
@@ -131,14 +137,92 @@ struct freshness_policy_traits {
         time::milliseconds freshness = item->payload()->GetData()->getFreshnessPeriod();
         if (freshness > time::milliseconds::zero()) {
           // erase only if freshness is positive (otherwise an item is not in the policy)
-          policy_container::erase(policy_container::s_iterator_to(*item));
+          get_wheel_slot(get_freshness(item)).erase(policy_container::s_iterator_to(*item));
+          --size_;
         }
       }
 
       inline void
       clear()
       {
-        policy_container::clear();
+        for (policy_container& slot : wheel_) {
+          slot.clear();
+        }
+        size_ = 0;
+      }
+
+      inline size_t
+      size() const
+      {
+        return size_;
+      }
+
+      inline bool
+      empty() const
+      {
+        return size_ == 0;
+      }
+
+      /**
+       * @brief Call @p onExpired for every entry whose freshness expired not later than @p now
+       *
+       * Only slots that ended since the previous call are visited, so an entry is passed to
+       * @p onExpired within one granularity interval after it expired. @p onExpired may erase
+       * the entry it is given.
+       */
+      template<class Callback>
+      void
+      expire(const Time& now, const Callback& onExpired)
+      {
+        int64_t lastSlot = now.GetTimeStep() / granularity_.GetTimeStep();
+        // slots of the same wheel position are visited at most once
+        int64_t firstSlot = std::max(nextSlot_, lastSlot - static_cast<int64_t>(wheel_.size()) + 1);
+
+        for (int64_t slot = firstSlot; slot <= lastSlot; ++slot) {
+          policy_container& entries = wheel_[slot % wheel_.size()];
+          for (typename policy_container::iterator entry = entries.begin(); entry != entries.end();) {
+            typename parent_trie::iterator item = &(*entry);
+            ++entry;
+            // the slot also holds entries that expire in a later turn of the wheel
+            if (get_freshness(item) <= now) {
+              onExpired(item);
+            }
+          }
+        }
+        nextSlot_ = lastSlot + 1;
+      }
+
+      /// @brief Get the time at which the slot in progress at @p now ends
+      inline Time
+      get_slot_end(const Time& now) const
+      {
+        return TimeStep((now.GetTimeStep() / granularity_.GetTimeStep() + 1)
+                        * granularity_.GetTimeStep());
+      }
+
+      inline void
+      set_granularity(const Time& granularity)
+      {
+        NS_ASSERT(granularity.IsStrictlyPositive());
+
+        // entries are relinked, as their slots depend on the granularity
+        policy_container entries;
+        for (policy_container& slot : wheel_) {
+          entries.splice(entries.end(), slot);
+        }
+        granularity_ = granularity;
+        nextSlot_ = 0;
+        while (!entries.empty()) {
+          typename parent_trie::iterator item = &entries.front();
+          entries.pop_front();
+          get_wheel_slot(get_freshness(item)).push_back(*item);
+        }
+      }
+
+      inline const Time&
+      get_granularity() const
+      {
+        return granularity_;
       }
 
       inline void
@@ -154,12 +238,26 @@ struct freshness_policy_traits {
       }
 
     private:
+      /// @brief Get the slot that is visited once @p expiry has passed
+      inline policy_container&
+      get_wheel_slot(const Time& expiry)
+      {
+        int64_t granularity = granularity_.GetTimeStep();
+        int64_t slot = (expiry.GetTimeStep() + granularity - 1) / granularity;
+        return wheel_[slot % wheel_.size()];
+      }
+
       type()
         : base_(*((Base*)0)){};
 
     private:
       Base& base_;
       size_t max_size_;
+
+      std::vector<policy_container> wheel_;
+      Time granularity_;
+      int64_t nextSlot_; ///< @brief first slot not visited by expire() yet
+      size_t size_;
     };
   };
 };
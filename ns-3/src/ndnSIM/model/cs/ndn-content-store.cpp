@@ -22,6 +22,7 @@
 #include "ns3/log.h"
 #include "ns3/packet.h"
 #include "../ndn-cxx/lp/tags.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/cs-entry.hpp"
 
 
 NS_LOG_COMPONENT_DEFINE("ndn.cs.ContentStore");
@@ -54,6 +55,12 @@ ContentStore::~ContentStore()
 {
 }
 
+bool
+ContentStore::AddUnsolicited(shared_ptr<const Data> data)
+{
+  return Add(data);
+}
+
 namespace cs {
 
 //////////////////////////////////////////////////////////////////////
@@ -61,17 +68,17 @@ namespace cs {
 Entry::Entry(Ptr<ContentStore> cs, shared_ptr<const Data> data)
   : m_cs(cs)
   , m_data(data)
-  , m_latency(0)
-  , m_time(0)
+  , m_retrievalCost(0)
 {
+  UpdateCurrentTime();
 }
 
-Entry::Entry(Ptr<ContentStore> cs, shared_ptr<const Data> data, long long latency, long long currenttime)
+Entry::Entry(Ptr<ContentStore> cs, shared_ptr<const Data> data, time::nanoseconds retrievalCost)
   : m_cs(cs)
   , m_data(data)
-  , m_latency(latency)
-  , m_time(currenttime)
+  , m_retrievalCost(::nfd::cs::encodeRetrievalCost(retrievalCost))
 {
+  UpdateCurrentTime();
 }
 
 const Name&
@@ -119,10 +126,10 @@ Entry::hasFunction()
   }
 }
 //*/
-const long long
-Entry::GetLatency()
+time::nanoseconds
+Entry::GetRetrievalCost() const
 {
-  return m_latency;
+  return ::nfd::cs::decodeRetrievalCost(m_retrievalCost);
 }
 
 const long long
@@ -64,7 +64,12 @@ public:
    */
   Entry(Ptr<ContentStore> cs, shared_ptr<const Data> data);
 
-  Entry(Ptr<ContentStore> cs, shared_ptr<const Data> data, long long latency, long long currenttime);
+  /**
+   * \brief Construct content store entry for Data retrieved at the given cost
+   *
+   * \param retrievalCost simulated time from sending the Interest upstream until the Data arrived
+   */
+  Entry(Ptr<ContentStore> cs, shared_ptr<const Data> data, time::nanoseconds retrievalCost);
 
   /**
    * \brief Get prefix of the stored entry
@@ -92,9 +97,17 @@ public:
   const bool
   hasFunction();
 
-  const long long
-  GetLatency();
+  /**
+   * \brief Get the cost of retrieving the Data again, i.e. its round-trip time when it was cached
+   *
+   * The cost is kept in microseconds, and saturates at about 71 minutes.
+   */
+  time::nanoseconds
+  GetRetrievalCost() const;
 
+  /**
+   * \brief Get simulated time of the last use, in nanoseconds since the clock epoch
+   */
   const long long
   GetCurrentTime();
 
@@ -104,7 +117,7 @@ public:
 private:
   Ptr<ContentStore> m_cs;        ///< \brief content store to which entry is added
   shared_ptr<const Data> m_data; ///< \brief non-modifiable Data
-  long long m_latency;
+  uint32_t m_retrievalCost;      ///< \brief retrieval cost in microseconds
   long long m_time;
 };
 
@@ -138,8 +151,10 @@ public:
    *
    * If an entry is found, it is promoted to the top of most recent
    * used entries index, \see m_contentStore
+   *
+   * \return the cached Data itself, not a copy, or nullptr if no entry matches
    */
-  virtual shared_ptr<Data>
+  virtual shared_ptr<const Data>
   Lookup(shared_ptr<const Interest> interest) = 0;
 
   /**
@@ -149,8 +164,22 @@ public:
   virtual bool
   Add(shared_ptr<const Data> data) = 0;
 
+  /**
+   * \brief Add a new content retrieved at the given cost to the content store.
+   * \param retrievalCost simulated time from sending the Interest upstream until the Data arrived
+   * \returns true if an existing entry was updated, false otherwise
+   */
+  virtual bool
+  Add(shared_ptr<const Data> data, time::nanoseconds retrievalCost) = 0;
+
+  /**
+   * \brief Add a Data packet that did not satisfy any pending Interest
+   *
+   * The default implementation adds it as any other content.
+   * \returns true if an existing entry was updated, false otherwise
+   */
   virtual bool
-  Add(shared_ptr<const Data> data, long long latency, long long currenttime) = 0;
+  AddUnsolicited(shared_ptr<const Data> data);
 
   // /*
   //  * \brief Add a new content to the content store.
@@ -27,6 +27,8 @@
 
 #include "apps/ndn-app.hpp"
 
+#include <ndn-cxx/lp/tags.hpp>
+
 NS_LOG_COMPONENT_DEFINE("ndn.AppLinkService");
 
 namespace ns3 {
@@ -55,13 +57,58 @@ AppLinkService::doSendInterest(const Interest& interest)
   Simulator::ScheduleNow(&App::OnInterest, m_app, interest.shared_from_this());
 }
 
+/** \brief per-delivery fields of a Data that applications and their tracers read
+ *
+ *  A cached Data is shared by every delivery of it, and a cache hit resets these fields before
+ *  an earlier delivery may have run.  Tags are immutable, so keeping the pointers is enough.
+ */
+struct DataDeliveryState
+{
+  explicit
+  DataDeliveryState(const Data& data)
+    : serviceTime(data.getServiceTime())
+    , functionName(data.getTag<lp::FunctionNameTag>())
+    , partialHop(data.getTag<lp::PartialHopTag>())
+    , count(data.getTag<lp::CountTag>())
+    , hopCount(data.getTag<lp::HopCountTag>())
+    , congestionMark(data.getTag<lp::CongestionMarkTag>())
+  {
+  }
+
+  void
+  restore(const Data& data) const
+  {
+    data.setServiceTime(serviceTime);
+    data.setTag(functionName);
+    data.setTag(partialHop);
+    data.setTag(count);
+    data.setTag(hopCount);
+    data.setTag(congestionMark);
+  }
+
+  time::milliseconds serviceTime;
+  shared_ptr<lp::FunctionNameTag> functionName;
+  shared_ptr<lp::PartialHopTag> partialHop;
+  shared_ptr<lp::CountTag> count;
+  shared_ptr<lp::HopCountTag> hopCount;
+  shared_ptr<lp::CongestionMarkTag> congestionMark;
+};
+
+static void
+deliverData(Ptr<App> app, shared_ptr<const Data> data, DataDeliveryState state)
+{
+  // the application reads the fields synchronously, so no other delivery can change them
+  state.restore(*data);
+  app->OnData(data);
+}
+
 void
 AppLinkService::doSendData(const Data& data)
 {
   NS_LOG_FUNCTION(this << &data);
 
   // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnData, m_app, data.shared_from_this());
+  Simulator::ScheduleNow(&deliverData, m_app, data.shared_from_this(), DataDeliveryState(data));
 }
 
 void
@@ -19,16 +19,11 @@
 
 #include "ndn-block-header.hpp"
 
-#include <iosfwd>
-#include <boost/iostreams/concepts.hpp>
-#include <boost/iostreams/stream.hpp>
-
 #include <ndn-cxx/encoding/tlv.hpp>
 #include <ndn-cxx/interest.hpp>
 #include <ndn-cxx/data.hpp>
 #include <ndn-cxx/lp/packet.hpp>
 
-namespace io = boost::iostreams;
 namespace nfdFace = nfd::face;
 
 namespace ns3 {
@@ -73,37 +68,56 @@ BlockHeader::Serialize(ns3::Buffer::Iterator start) const
   start.Write(m_block.wire(), m_block.size());
 }
 
-class Ns3BufferIteratorSource : public io::source {
-public:
-  Ns3BufferIteratorSource(ns3::Buffer::Iterator& is)
-    : m_is(is)
-  {
+/**
+ * @brief Read TLV-TYPE or TLV-LENGTH directly from the ns-3 buffer
+ * @throw ::ndn::tlv::Error the buffer ends before the number
+ */
+static uint64_t
+readVarNumber(ns3::Buffer::Iterator& i)
+{
+  if (i.GetRemainingSize() < 1) {
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("Insufficient data during TLV processing"));
   }
 
-  std::streamsize
-  read(char* buf, std::streamsize nMaxRead)
-  {
-    std::streamsize i = 0;
-    for (; i < nMaxRead && !m_is.IsEnd(); ++i) {
-      buf[i] = m_is.ReadU8();
-    }
-    if (i == 0) {
-      return -1;
-    }
-    else {
-      return i;
-    }
+  uint8_t firstOctet = i.ReadU8();
+  uint32_t nOctets = firstOctet == 253 ? 2 : firstOctet == 254 ? 4 : firstOctet == 255 ? 8 : 0;
+  if (i.GetRemainingSize() < nOctets) {
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("Insufficient data during TLV processing"));
   }
 
-private:
-  ns3::Buffer::Iterator& m_is;
-};
+  switch (firstOctet) {
+    case 253:
+      return i.ReadNtohU16();
+    case 254:
+      return i.ReadNtohU32();
+    case 255:
+      return i.ReadNtohU64();
+    default:
+      return firstOctet;
+  }
+}
 
 uint32_t
 BlockHeader::Deserialize(ns3::Buffer::Iterator start)
 {
-  io::stream<Ns3BufferIteratorSource> is(start);
-  m_block = ::ndn::Block::fromStream(is);
+  // Peek at TLV-TYPE and TLV-LENGTH to learn the block size, so that the block is read from the
+  // packet once, into a buffer of its final size that Block wraps without another copy.
+  // Buffer::Iterator::Read still copies one octet at a time.
+  ns3::Buffer::Iterator i = start;
+  readVarNumber(i);
+  uint64_t length = readVarNumber(i);
+  uint64_t size = i.GetDistanceFrom(start) + length;
+
+  if (size > ::ndn::MAX_NDN_PACKET_SIZE) {
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("Length of block from ns-3 packet is too large"));
+  }
+  if (length > i.GetRemainingSize()) {
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("Not enough data in ns-3 packet for the block"));
+  }
+
+  auto buffer = make_shared< ::ndn::Buffer>(size);
+  start.Read(buffer->get(), size);
+  m_block = Block(buffer);
   return m_block.size();
 }
 
@@ -145,6 +159,20 @@ BlockHeader::Print(std::ostream& os) const
         os << ")";
         break;
       }
+      case lp::tlv::LpBundle: {
+        os << "NDNLP bundle(";
+        block.parse();
+        bool isFirst = true;
+        for (const Block& element : block.elements()) {
+          if (!isFirst) {
+            os << ", ";
+          }
+          isFirst = false;
+          decodeAndPrint(element);
+        }
+        os << ")";
+        break;
+      }
       default: {
         os << "Unrecognized";
         break;
@@ -206,6 +206,14 @@ L3Protocol::initialize(Ptr<Node> node)
 {
   m_impl->m_forwarder = make_shared<nfd::Forwarder>();
   m_impl->m_forwarder->setNode(node);
+  m_impl->m_forwarder->setLoopDetectionEnabled(
+    this->getConfig().get<bool>("ndnSIM.enable_loop_detection", false));
+  m_impl->m_forwarder->setMeasuredInstanceSelectionEnabled(
+    this->getConfig().get<bool>("ndnSIM.enable_measured_instance_selection", false));
+  m_impl->m_forwarder->setInterestBatchingEnabled(
+    this->getConfig().get<bool>("ndnSIM.enable_interest_batching", false));
+  m_impl->m_forwarder->setCacheHitFastPathEnabled(
+    this->getConfig().get<bool>("ndnSIM.enable_cache_hit_fast_path", false));
 
   initializeManagement();
 
@@ -396,7 +404,11 @@ L3Protocol::NotifyNewAggregate()
       NS_ASSERT(m_impl->m_forwarder != nullptr);
       m_impl->m_csFromNdnSim = GetObject<ContentStore>();
       if (m_impl->m_csFromNdnSim != nullptr) {
-        m_impl->m_forwarder->setCsFromNdnSim(m_impl->m_csFromNdnSim);
+        m_impl->m_forwarder->setContentStore(m_impl->m_csFromNdnSim);
+      }
+      else {
+        // NFD's Cs is reached through the same interface, e.g., by CsTracer
+        AggregateObject(m_impl->m_forwarder->getContentStore());
       }
     }
   }
@@ -23,6 +23,8 @@
 #include "ndn-block-header.hpp"
 #include "../utils/ndn-ns3-packet-tag.hpp"
 
+#include "ns3/queue.h"
+
 #include <ndn-cxx/encoding/block.hpp>
 #include <ndn-cxx/interest.hpp>
 #include <ndn-cxx/data.hpp>
@@ -95,8 +97,27 @@ NetDeviceTransport::doSend(Packet&& packet)
   ns3Packet->AddHeader(header);
 
   // send the NS3 packet
-  m_netDevice->Send(ns3Packet, m_netDevice->GetBroadcast(),
-                    L3Protocol::ETHERNET_FRAME_TYPE);
+  bool isQueued = m_netDevice->Send(ns3Packet, m_netDevice->GetBroadcast(),
+                                    L3Protocol::ETHERNET_FRAME_TYPE);
+  if (!isQueued) {
+    NS_LOG_DEBUG("Packet dropped by netDevice with URI " << this->getLocalUri()
+                 << ", transmit queue is full");
+  }
+}
+
+ssize_t
+NetDeviceTransport::getSendQueueLength()
+{
+  Ptr<PointToPointNetDevice> p2pDevice = DynamicCast<PointToPointNetDevice>(m_netDevice);
+  if (p2pDevice == nullptr) {
+    return nfd::face::QUEUE_UNSUPPORTED;
+  }
+
+  Ptr<Queue> queue = p2pDevice->GetQueue();
+  if (queue == nullptr) {
+    return nfd::face::QUEUE_UNSUPPORTED;
+  }
+  return queue->GetNBytes();
 }
 
 // callback
@@ -109,11 +130,10 @@ NetDeviceTransport::receiveFromNetDevice(Ptr<NetDevice> device,
 {
   NS_LOG_FUNCTION(device << p << protocol << from << to << packetType);
 
-  // Convert NS3 packet to NFD packet
-  Ptr<ns3::Packet> packet = p->Copy();
-
+  // Convert NS3 packet to NFD packet; the header is only peeked, so there is no need to copy
+  // the (shared) ns-3 packet first
   BlockHeader header;
-  packet->RemoveHeader(header);
+  p->PeekHeader(header);
 
   auto nfdPacket = Packet(std::move(header.getBlock()));
 
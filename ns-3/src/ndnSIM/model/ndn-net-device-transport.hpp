@@ -54,6 +54,14 @@ public:
   Ptr<NetDevice>
   GetNetDevice() const;
 
+  /**
+   * \brief Get the number of bytes waiting in the transmit queue of the NetDevice
+   *
+   * Only PointToPointNetDevice exposes its queue; QUEUE_UNSUPPORTED is returned for others.
+   */
+  virtual ssize_t
+  getSendQueueLength() override;
+
 private:
   virtual void
   beforeChangePersistency(::ndn::nfd::FacePersistency newPersistency) override;
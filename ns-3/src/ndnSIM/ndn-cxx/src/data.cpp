@@ -33,12 +33,14 @@ static_assert(std::is_base_of<tlv::Error, Data::Error>::value,
               "Data::Error must inherit from tlv::Error");
 
 Data::Data()
-  : m_content(tlv::Content) // empty content
+  : m_serviceTime(0)
+  , m_content(tlv::Content) // empty content
 {
 }
 
 Data::Data(const Name& name)
   : m_name(name)
+  , m_serviceTime(0)
 {
 }
 
@@ -165,6 +167,8 @@ void
 Data::wireDecode(const Block& wire)
 {
   m_fullName.clear();
+  m_functionName.clear();
+  m_functionNameWire.reset();
   m_wire = wire;
   m_wire.parse();
 
@@ -180,9 +184,10 @@ Data::wireDecode(const Block& wire)
 
   // Function Name by konomu
 ///* 
+    // kept as a sub-element sharing the wire buffer, and decoded by getFunction() if needed
     Block::element_const_iterator val1 = m_wire.find(tlv::FunctionName);
     if (val1 != m_wire.elements_end()){
-     m_functionName.wireDecodeFunc(*val1);
+     m_functionNameWire = *val1;
  }
 //*/
 //ServiceTime
@@ -252,6 +257,7 @@ Data::setName(const Name& name)
  {
    onChanged();
  	m_functionName = name;
+ 	m_functionNameWire.reset();
  }
 //*/
 
@@ -241,6 +241,10 @@ public:
   void
   setServiceTime(const time::milliseconds& serviceTime) const
   {
+    if (serviceTime == m_serviceTime) {
+      // keep the wire encoding, e.g. of a cached Data served again with the same ServiceTime
+      return;
+    }
     m_serviceTime = serviceTime;
     m_wire.reset();
     //return *this;
@@ -350,6 +354,7 @@ protected:
 private:
   Name m_name;
   mutable Name m_functionName; //by konomu
+  mutable Block m_functionNameWire; ///< FunctionName not decoded yet, if hasWire()
   mutable time::milliseconds m_serviceTime;
   mutable MetaInfo m_metaInfo;
   mutable Block m_content;
@@ -378,6 +383,11 @@ Data::getName() const
  inline const Name&
  Data::getFunction() const
  {
+ 	if (m_functionNameWire.hasWire()) {
+ 		// decoded on first access, see wireDecode
+ 		m_functionName.wireDecodeFunc(m_functionNameWire);
+ 		m_functionNameWire.reset();
+ 	}
  	return m_functionName;
  }
 //*/
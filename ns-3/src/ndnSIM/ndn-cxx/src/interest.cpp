@@ -213,7 +213,7 @@ Interest::matchesData(const Data& data) const
 
 	if(ns3::getChoiceType() == 4){
 		if(data.getTag<lp::FunctionNameTag>() != nullptr){
-			if(m_functionName.compare(*(data.getTag<lp::FunctionNameTag>())) != 0){
+			if(getFunction().compare(*(data.getTag<lp::FunctionNameTag>())) != 0){
 				return false;
 			}
 		}
@@ -321,6 +321,18 @@ Interest::wireEncode() const
 	if (m_wire.hasWire())
 		return m_wire;
 
+	if (m_wire.type() == tlv::Interest && !m_wire.elements().empty()) {
+		// only spliced SFC fields changed since the last encoding:
+		// concatenate the sub-elements instead of encoding and decoding the whole Interest
+		m_wire.encode();
+		m_wire = Block(m_wire.getBuffer());
+		m_wire.parse();
+
+		// to ensure that Nonce block points to the right memory location
+		m_nonce = m_wire.get(tlv::Nonce);
+		return m_wire;
+	}
+
 	EncodingEstimator estimator;
 	size_t estimatedSize = wireEncode(estimator);
 
@@ -333,6 +345,89 @@ Interest::wireEncode() const
 	return m_wire;
 }
 
+Block
+Interest::encodeFunctionField(uint32_t type) const
+{
+	// the conditions must match those in wireEncode(EncodingImpl<TAG>&)
+	switch (type) {
+	case tlv::FunctionTime:
+		if (getFunctionTime() >= time::milliseconds::zero() &&
+				getFunctionTime() != DEFAULT_SERVICETIME)
+			return makeNonNegativeIntegerBlock(tlv::FunctionTime, getFunctionTime().count());
+		break;
+	case tlv::ServiceTime:
+		if (getServiceTime() >= time::milliseconds::zero() &&
+				getServiceTime() != DEFAULT_SERVICETIME)
+			return makeNonNegativeIntegerBlock(tlv::ServiceTime, getServiceTime().count());
+		break;
+	case tlv::FunctionFlag:
+		if (getFunctionFlag() >= 0)
+			return makeNonNegativeIntegerBlock(tlv::FunctionFlag, getFunctionFlag());
+		break;
+	case tlv::FunctionName:
+	case tlv::FunctionNextName:
+	case tlv::FunctionFullName: {
+		const Name& name = type == tlv::FunctionName ? getFunction() :
+				type == tlv::FunctionNextName ? getFunctionNextName() : getFunctionFullName();
+		EncodingEstimator estimator;
+		EncodingBuffer encoder(name.prependNameBlock(estimator, type), 0);
+		name.prependNameBlock(encoder, type);
+		return encoder.block();
+	}
+	default:
+		BOOST_ASSERT(false);
+		break;
+	}
+	return Block();
+}
+
+void
+Interest::spliceWire(uint32_t type) const
+{
+	if (m_wire.type() != tlv::Interest || m_wire.elements().empty()) {
+		// never encoded, or already fully invalidated
+		m_wire.reset();
+		return;
+	}
+
+	Block element = encodeFunctionField(type);
+	Block::element_const_iterator it = m_wire.find(type);
+	if (it == m_wire.elements_end()) {
+		if (element.hasWire()) {
+			// inserting an optional field at its canonical position is left to a full encoding
+			m_wire.reset();
+		}
+		return;
+	}
+
+	Block::element_iterator next = m_wire.erase(it);
+	if (element.hasWire()) {
+		m_wire.insert(next, element);
+	}
+}
+
+void
+Interest::decodeFunctionField(uint32_t type) const
+{
+	switch (type) {
+	case tlv::FunctionName:
+		m_functionName.wireDecodeFunc(m_functionNameWire);
+		m_functionNameWire.reset();
+		break;
+	case tlv::FunctionNextName:
+		m_functionNextName.wireDecodeFuncNextName(m_functionNextNameWire);
+		m_functionNextNameWire.reset();
+		break;
+	case tlv::FunctionFullName:
+		m_functionFullName.wireDecodeFuncFullName(m_functionFullNameWire);
+		m_functionFullNameWire.reset();
+		break;
+	default:
+		BOOST_ASSERT(false);
+		break;
+	}
+}
+
 void
 Interest::wireDecode(const Block& wire)
 {
@@ -401,12 +496,12 @@ Interest::wireDecode(const Block& wire)
 		m_selectedDelegationIndex = INVALID_SELECTED_DELEGATION_INDEX;
 	}
 
-	//FunctionName
-	m_functionName.wireDecodeFunc(m_wire.get(tlv::FunctionName));
+	//FunctionName, FunctionNextName, FunctionFullName: decoded on first access
+	m_functionNameWire = m_wire.get(tlv::FunctionName);
 
-	m_functionNextName.wireDecodeFuncNextName(m_wire.get(tlv::FunctionNextName));
+	m_functionNextNameWire = m_wire.get(tlv::FunctionNextName);
 
-	m_functionFullName.wireDecodeFuncFullName(m_wire.get(tlv::FunctionFullName));
+	m_functionFullNameWire = m_wire.get(tlv::FunctionFullName);
 
 	//FunctionFlag
 	val = m_wire.find(tlv::FunctionFlag);
@@ -231,6 +231,8 @@ public: // Name and guiders
   const Name&
   getFunctionFullName() const
   {
+	  if (m_functionFullNameWire.hasWire())
+		  this->decodeFunctionField(tlv::FunctionFullName);
 	  return m_functionFullName;
   }
 
@@ -238,31 +240,34 @@ public: // Name and guiders
   setFunctionFullName(const Name& name)
   {
 	  m_functionFullName = name;
-	  m_wire.reset();
+	  m_functionFullNameWire.reset();
+	  this->spliceWire(tlv::FunctionFullName);
   }
 
   void
   setFunctionFullName(const Name& name) const
     {
   	  m_functionFullName = name;
-  	  m_wire.reset();
+  	  m_functionFullNameWire.reset();
+  	  this->spliceWire(tlv::FunctionFullName);
     }
 
   void
   addFunctionFullName(Name name) const
   {
-	  std::string oldFunc = m_functionFullName.toUri();
+	  std::string oldFunc = getFunctionFullName().toUri();
 	  std::string newFunc = name.toUri();
 	  newFunc += oldFunc;
 	  //std::cout << "newFunc: " << newFunc << ", name: " << name.toUri() <<std::endl;
 	  shared_ptr<Name> addFunc = make_shared<Name>(Name(newFunc));
 	  this->setFunctionFullName(*addFunc);
-	  m_wire.reset();
   }
 
   const Name&
   getFunctionNextName() const
   {
+	  if (m_functionNextNameWire.hasWire())
+		  this->decodeFunctionField(tlv::FunctionNextName);
 	  return m_functionNextName;
   }
 
@@ -270,19 +275,23 @@ public: // Name and guiders
   setFunctionNextName(const Name& name)
   {
 	  m_functionNextName = name;
-	  m_wire.reset();
+	  m_functionNextNameWire.reset();
+	  this->spliceWire(tlv::FunctionNextName);
   }
 
   void
   setFunctionNextName(const Name& name) const
     {
   	  m_functionNextName = name;
-  	  m_wire.reset();
+  	  m_functionNextNameWire.reset();
+  	  this->spliceWire(tlv::FunctionNextName);
     }
 
   const Name&
   getFunction() const
   {
+    if (m_functionNameWire.hasWire())
+      this->decodeFunctionField(tlv::FunctionName);
     return m_functionName;
   }
 
@@ -291,7 +300,8 @@ public: // Name and guiders
   const
   {
     m_functionName = functionName;
-    m_wire.reset();
+    m_functionNameWire.reset();
+    this->spliceWire(tlv::FunctionName);
     //return *this;
   }
 
@@ -311,7 +321,6 @@ public: // Name and guiders
       Name newFunc(funcStr);
       interest.setFunction(newFunc);
     }
-    m_wire.reset();
   }
 
   //defined by yamaguchi
@@ -333,7 +342,6 @@ public: // Name and guiders
 		Name newFunc(headFunc);
 		interest.setFunction(newFunc);
 	}
-	m_wire.reset();
   }
 
   const time::milliseconds&
@@ -360,7 +368,7 @@ public: // Name and guiders
   setServiceTime(const time::milliseconds& serviceTime) const
   {
     m_serviceTime = serviceTime;
-    m_wire.reset();
+    this->spliceWire(tlv::ServiceTime);
     //return *this;
   }
 
@@ -375,7 +383,7 @@ public: // Name and guiders
   setFunctionTime(const time::milliseconds& functionTime) const
   {
     m_functionTime = functionTime;
-    m_wire.reset();
+    this->spliceWire(tlv::FunctionTime);
     //return *this;
   }
 
@@ -389,7 +397,7 @@ public: // Name and guiders
   setFunctionFlag(const int functionFlag) const
   {
     m_functionFlag = functionFlag;
-    m_wire.reset();
+    this->spliceWire(tlv::FunctionFlag);
   }
 
   /** @brief Check if Nonce set
@@ -546,11 +554,40 @@ public: // EqualityComparable concept
     return !(*this == other);
   }
 
+private:
+  /** @brief bring the wire encoding up to date after the SFC field \p type has changed
+   *
+   *  If the Interest has been encoded and \p type is already present in (or still absent from)
+   *  the encoding, only that sub-element is replaced or removed; the other sub-elements keep
+   *  sharing the existing buffer and the next wireEncode() just concatenates them.
+   *  Otherwise, the wire encoding is discarded.
+   */
+  void
+  spliceWire(uint32_t type) const;
+
+  /** @brief encode the SFC field \p type as a sub-element
+   *  @return the sub-element, or an invalid Block if the field is omitted from the encoding
+   */
+  Block
+  encodeFunctionField(uint32_t type) const;
+
+  /** @brief decode the function Name \p type from the sub-element kept by wireDecode
+   *
+   *  Function Names are decoded component by component, and most hops only look at the head
+   *  function, so wireDecode keeps their sub-elements (sharing the wire buffer) and each one
+   *  is decoded when first accessed.
+   */
+  void
+  decodeFunctionField(uint32_t type) const;
+
 private:
   Name m_name;
   mutable Name m_functionNextName;
   mutable Name m_functionFullName;
   mutable Name m_functionName;
+  mutable Block m_functionNextNameWire; ///< FunctionNextName not decoded yet, if hasWire()
+  mutable Block m_functionFullNameWire; ///< FunctionFullName not decoded yet, if hasWire()
+  mutable Block m_functionNameWire;     ///< FunctionName not decoded yet, if hasWire()
   Selectors m_selectors;
   mutable Block m_nonce;
   time::milliseconds m_interestLifetime;
@@ -31,6 +31,7 @@ namespace tlv {
  */
 enum {
   LpPacket = 100,
+  LpBundle = 101,//added for link-layer bundling, a sequence of LpPackets in one frame
   Fragment = 80,
   Sequence = 81,
   FragIndex = 82,
@@ -33,6 +33,8 @@
 
 #include <boost/functional/hash.hpp>
 
+#include <cctype>
+
 namespace ndn {
 
 BOOST_CONCEPT_ASSERT((boost::EqualityComparable<Name>));
@@ -44,6 +46,40 @@ static_assert(std::is_base_of<tlv::Error, Name::Error>::value,
 
 const size_t Name::npos = std::numeric_limits<size_t>::max();
 
+/**
+ * @brief Prepend the NameComponent escaped as uri[begin, end) to @p encoder
+ * @param value scratch space for the unescaped value, reused across components
+ *
+ * Generic components are unescaped in place; anything that needs special treatment
+ * (ImplicitSha256Digest, components made only of periods) goes through
+ * Component::fromEscapedString.
+ */
+static size_t
+prependEscapedComponent(EncodingBuffer& encoder, const std::string& uri, size_t begin, size_t end,
+		std::string& value)
+{
+	while (begin < end && std::isspace(static_cast<unsigned char>(uri[begin])))
+		++begin;
+	while (end > begin && std::isspace(static_cast<unsigned char>(uri[end - 1])))
+		--end;
+
+	static const std::string sha256DigestPrefix("sha256digest=");
+	if (end - begin >= sha256DigestPrefix.size() &&
+			uri.compare(begin, sha256DigestPrefix.size(), sha256DigestPrefix) == 0) {
+		return name::Component::fromEscapedString(uri.data(), begin, end).wireEncode(encoder);
+	}
+
+	value.clear();
+	unescape(uri.data() + begin, uri.data() + end, value);
+
+	if (value.find_first_not_of('.') == std::string::npos) {
+		return name::Component::fromEscapedString(uri.data(), begin, end).wireEncode(encoder);
+	}
+
+	return encoder.prependByteArrayBlock(tlv::NameComponent,
+			reinterpret_cast<const uint8_t*>(value.data()), value.size());
+}
+
 Name::Name()
 : m_nameBlock(tlv::Name)
 {
@@ -61,6 +97,7 @@ Name::Name(const char* uri)
 }
 
 Name::Name(std::string uri)
+: m_nameBlock(tlv::Name)
 {
 	trim(uri);
 	if (uri.empty())
@@ -96,17 +133,36 @@ Name::Name(std::string uri)
 		}
 	}
 
-	size_t iComponentStart = 0;
+	if (uri.empty())
+		return;
+
+	// Unescape the components straight into a single wire buffer, so that all components share
+	// one allocation instead of each holding its own.  The encoder prepends, hence components
+	// are visited from the last one to the first; a single trailing '/' is ignored.
+	EncodingBuffer encoder(uri.size() + 16, 0);
+	std::string value;
+	size_t totalLength = 0;
+
+	size_t iComponentEnd = uri.size();
+	if (uri[iComponentEnd - 1] == '/')
+		--iComponentEnd;
+
+	while (true) {
+		size_t iSlash = iComponentEnd == 0 ? std::string::npos : uri.rfind('/', iComponentEnd - 1);
+		size_t iComponentStart = iSlash == std::string::npos ? 0 : iSlash + 1;
 
-	// Unescape the components.
-	while (iComponentStart < uri.size()) {
-		size_t iComponentEnd = uri.find("/", iComponentStart);
-		if (iComponentEnd == std::string::npos)
-			iComponentEnd = uri.size();
+		totalLength += prependEscapedComponent(encoder, uri, iComponentStart, iComponentEnd, value);
 
-		append(Component::fromEscapedString(&uri[0], iComponentStart, iComponentEnd));
-		iComponentStart = iComponentEnd + 1;
+		if (iSlash == std::string::npos)
+			break;
+		iComponentEnd = iSlash;
 	}
+
+	totalLength += encoder.prependVarNumber(totalLength);
+	encoder.prependVarNumber(tlv::Name);
+
+	m_nameBlock = encoder.block();
+	m_nameBlock.parse();
 }
 
 Name
@@ -405,6 +461,23 @@ Name::getSubName(ssize_t iStartComponent, size_t nComponents) const
 	if (nComponents != npos)
 		iEnd = std::min(this->size(), iStart + nComponents);
 
+	if (static_cast<size_t>(iStart) >= iEnd)
+		return result;
+
+	if (m_nameBlock.hasWire()) {
+		// Components of an encoded name are contiguous in its wire, so the sub-name is encoded
+		// with a single copy.  The result owns a compact buffer instead of pinning the (often
+		// much larger) packet buffer this name was decoded from.
+		const uint8_t* first = at(iStart).wire();
+		size_t valueLength = at(iEnd - 1).wire() + at(iEnd - 1).size() - first;
+
+		EncodingBuffer encoder(valueLength + 10, 0);
+		encoder.prependByteArrayBlock(tlv::Name, first, valueLength);
+		result.m_nameBlock = encoder.block();
+		result.m_nameBlock.parse();
+		return result;
+	}
+
 	for (size_t i = iStart; i < iEnd; ++i)
 		result.append(at(i));
 
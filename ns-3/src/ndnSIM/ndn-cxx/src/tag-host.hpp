@@ -25,10 +25,35 @@
 #include "common.hpp"
 #include "tag.hpp"
 
-#include <map>
+#include <array>
+#include <vector>
 
 namespace ndn {
 
+namespace detail {
+
+/** \brief number of tag types that TagHost stores in inline slots
+ */
+const size_t N_INLINE_TAG_SLOTS = 10;
+
+/** \brief returned by getInlineTagSlot for a tag type without inline slot
+ */
+const size_t NO_INLINE_TAG_SLOT = N_INLINE_TAG_SLOTS;
+
+/** \return inline slot of tag type \p typeId, or NO_INLINE_TAG_SLOT
+ *
+ *  The link protocol tags (TypeId 10 to 18, see lp/tags.hpp) and HopCountTag are set and
+ *  read on every hop, so each of them has an inline slot; other tag types are kept in a list.
+ */
+constexpr size_t
+getInlineTagSlot(uint64_t typeId)
+{
+  return typeId >= 10 && typeId <= 18 ? static_cast<size_t>(typeId - 10) :
+         typeId == 0x60000000 ? 9 : NO_INLINE_TAG_SLOT;
+}
+
+} // namespace detail
+
 /** \brief Base class to store tag information (e.g., inside Interest and Data packets)
  */
 class TagHost
@@ -58,7 +83,20 @@ public:
   removeTag() const;
 
 private:
-  mutable std::map<size_t, shared_ptr<Tag>> m_tags;
+  shared_ptr<Tag>
+  getOtherTag(uint64_t typeId) const;
+
+  void
+  setOtherTag(uint64_t typeId, shared_ptr<Tag> tag) const;
+
+private:
+  /** \brief tags of the types that have an inline slot, indexed by detail::getInlineTagSlot
+   */
+  mutable std::array<shared_ptr<Tag>, detail::N_INLINE_TAG_SLOTS> m_inlineTags;
+
+  /** \brief tags of the other types, usually none or very few
+   */
+  mutable std::vector<std::pair<uint64_t, shared_ptr<Tag>>> m_otherTags;
 };
 
 
@@ -68,11 +106,13 @@ TagHost::getTag() const
 {
   static_assert(std::is_base_of<Tag, T>::value, "T must inherit from Tag");
 
-  auto it = m_tags.find(T::getTypeId());
-  if (it == m_tags.end()) {
-    return nullptr;
+  // getTypeId of tag types outside ndn-cxx is not always constexpr; the slot is still
+  // folded to a constant when it is
+  const size_t slot = detail::getInlineTagSlot(T::getTypeId());
+  if (slot != detail::NO_INLINE_TAG_SLOT) {
+    return static_pointer_cast<T>(m_inlineTags[slot]);
   }
-  return static_pointer_cast<T>(it->second);
+  return static_pointer_cast<T>(this->getOtherTag(T::getTypeId()));
 }
 
 template<typename T>
@@ -81,12 +121,12 @@ TagHost::setTag(shared_ptr<T> tag) const
 {
   static_assert(std::is_base_of<Tag, T>::value, "T must inherit from Tag");
 
-  if (tag == nullptr) {
-    m_tags.erase(T::getTypeId());
+  const size_t slot = detail::getInlineTagSlot(T::getTypeId());
+  if (slot != detail::NO_INLINE_TAG_SLOT) {
+    m_inlineTags[slot] = std::move(tag);
     return;
   }
-
-  m_tags[T::getTypeId()] = tag;
+  this->setOtherTag(T::getTypeId(), std::move(tag));
 }
 
 template<typename T>
@@ -96,6 +136,39 @@ TagHost::removeTag() const
   setTag<T>(nullptr);
 }
 
+inline shared_ptr<Tag>
+TagHost::getOtherTag(uint64_t typeId) const
+{
+  for (const auto& tag : m_otherTags) {
+    if (tag.first == typeId) {
+      return tag.second;
+    }
+  }
+  return nullptr;
+}
+
+inline void
+TagHost::setOtherTag(uint64_t typeId, shared_ptr<Tag> tag) const
+{
+  auto it = std::find_if(m_otherTags.begin(), m_otherTags.end(),
+                         [typeId] (const std::pair<uint64_t, shared_ptr<Tag>>& other) {
+                           return other.first == typeId;
+                         });
+  if (tag == nullptr) {
+    if (it != m_otherTags.end()) {
+      m_otherTags.erase(it);
+    }
+    return;
+  }
+
+  if (it != m_otherTags.end()) {
+    it->second = std::move(tag);
+  }
+  else {
+    m_otherTags.emplace_back(typeId, std::move(tag));
+  }
+}
+
 } // namespace ndn
 
 #endif // NDN_TAG_HOST_HPP
@@ -127,28 +127,33 @@ trim(std::string& str)
 std::string
 unescape(const std::string& str)
 {
-  std::ostringstream result;
+  std::string result;
+  result.reserve(str.size());
+  unescape(str.data(), str.data() + str.size(), result);
+  return result;
+}
 
-  for (size_t i = 0; i < str.size(); ++i) {
-    if (str[i] == '%' && i + 2 < str.size()) {
-      int hi = fromHexChar(str[i + 1]);
-      int lo = fromHexChar(str[i + 2]);
+void
+unescape(const char* begin, const char* end, std::string& output)
+{
+  for (const char* i = begin; i != end; ++i) {
+    if (*i == '%' && end - i > 2) {
+      int hi = fromHexChar(i[1]);
+      int lo = fromHexChar(i[2]);
 
       if (hi < 0 || lo < 0)
         // Invalid hex characters, so just keep the escaped string.
-        result << str[i] << str[i + 1] << str[i + 2];
+        output.append(i, 3);
       else
-        result << static_cast<char>((hi << 4) | lo);
+        output.push_back(static_cast<char>((hi << 4) | lo));
 
       // Skip ahead past the escaped value.
       i += 2;
     }
     else
       // Just copy through.
-      result << str[i];
+      output.push_back(*i);
   }
-
-  return result.str();
 }
 
 } // namespace ndn
@@ -142,6 +142,15 @@ fromHexChar(uint8_t c);
 std::string
 unescape(const std::string& str);
 
+/**
+ * @brief Decode a percent-encoded character range, appending the result to @p output
+ *
+ * This is the allocation-free counterpart of unescape(const std::string&): the caller can
+ * reuse @p output across calls.
+ */
+void
+unescape(const char* begin, const char* end, std::string& output);
+
 } // namespace ndn
 
 #endif // NDN_STRING_HELPER_HPP
@@ -358,6 +358,46 @@ BOOST_FIXTURE_TEST_CASE(FullName, IdentityManagementFixture)
     "sha256digest=28bad4b5275bd392dbb670c75cf0b66f13f7942b21e80f55c0e86b374753a548");
 }
 
+BOOST_FIXTURE_TEST_CASE(ServiceTime, IdentityManagementFixture)
+{
+  Data d(Name("/local/ndn/prefix"));
+  BOOST_CHECK_EQUAL(d.getServiceTime(), time::milliseconds(0));
+  d.setServiceTime(time::milliseconds(40));
+  m_keyChain.sign(d);
+  BOOST_CHECK(d.hasWire());
+
+  // setting the same ServiceTime keeps the wire encoding
+  d.setServiceTime(time::milliseconds(40));
+  BOOST_CHECK(d.hasWire());
+
+  d.setServiceTime(time::milliseconds(50));
+  BOOST_CHECK(!d.hasWire());
+
+  Data decoded(d.wireEncode());
+  BOOST_CHECK_EQUAL(decoded.getServiceTime(), time::milliseconds(50));
+}
+
+BOOST_FIXTURE_TEST_CASE(FunctionNameRedecode, IdentityManagementFixture)
+{
+  Data withFunction(Name("/local/ndn/prefix"));
+  withFunction.setFunction("/F1/F2");
+  m_keyChain.sign(withFunction);
+
+  Data withoutFunction(Name("/local/ndn/prefix"));
+  m_keyChain.sign(withoutFunction);
+
+  // FunctionName of a previously decoded packet is not kept, whether it was read or not
+  Data d;
+  d.wireDecode(withFunction.wireEncode());
+  d.wireDecode(withoutFunction.wireEncode());
+  BOOST_CHECK(d.getFunction().empty());
+
+  d.wireDecode(withFunction.wireEncode());
+  BOOST_CHECK_EQUAL(d.getFunction(), Name("/F1/F2"));
+  d.wireDecode(withoutFunction.wireEncode());
+  BOOST_CHECK(d.getFunction().empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
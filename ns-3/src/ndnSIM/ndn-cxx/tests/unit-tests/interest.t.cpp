@@ -1020,6 +1020,76 @@ BOOST_AUTO_TEST_CASE(DecodeEncode) // this test case to ensure that wireDecode r
   BOOST_CHECK_EQUAL(i2.hasSelectedDelegation(), false);
 }
 
+BOOST_AUTO_TEST_CASE(SpliceFunctionFields)
+{
+  Interest original("/A/B");
+  original.setNonce(5);
+  original.setFunction("/F1/F2");
+  original.setFunctionFlag(1);
+  original.setServiceTime(time::milliseconds(3));
+  original.setFunctionTime(time::milliseconds(0));
+  Block originalWire = original.wireEncode();
+
+  Interest interest(originalWire);
+  interest.removeHeadFunction(interest);
+  interest.addFunctionFullName("/X");
+  interest.setFunctionFlag(0);
+  interest.setServiceTime(time::milliseconds(400));
+  BOOST_CHECK(!interest.hasWire());
+
+  Interest expected("/A/B");
+  expected.setNonce(5);
+  expected.setFunction("/F2");
+  expected.setFunctionFullName("/X");
+  expected.setFunctionFlag(0);
+  expected.setServiceTime(time::milliseconds(400));
+  expected.setFunctionTime(time::milliseconds(0));
+
+  // spliced encoding equals a full encoding, and leaves the original wire untouched
+  BOOST_CHECK(interest.wireEncode() == expected.wireEncode());
+  BOOST_CHECK(original.wireEncode() == originalWire);
+  BOOST_CHECK_EQUAL(Interest(originalWire).getFunction(), "/F1/F2");
+
+  // Nonce still refers to the reassembled wire
+  interest.setNonce(7);
+  BOOST_CHECK_EQUAL(Interest(interest.wireEncode()).getNonce(), 7);
+
+  // fields dropped from or added to the encoding
+  interest.setServiceTime(time::milliseconds(0));
+  BOOST_CHECK(interest.wireEncode().find(tlv::ServiceTime) == interest.wireEncode().elements_end());
+  interest.setFunctionTime(time::milliseconds(9));
+  BOOST_CHECK_EQUAL(Interest(interest.wireEncode()).getFunctionTime(), time::milliseconds(9));
+}
+
+BOOST_AUTO_TEST_CASE(LazyFunctionFields)
+{
+  Interest original("/A/B");
+  original.setNonce(5);
+  original.setFunction("/F1/F2");
+  original.setFunctionNextName("/F1a");
+  original.setFunctionFullName("/F0b");
+  Block originalWire = original.wireEncode();
+
+  // copies made before the function Names are accessed decode them independently
+  Interest interest(originalWire);
+  Interest copy(interest);
+  BOOST_CHECK_EQUAL(interest.getFunction(), "/F1/F2");
+  BOOST_CHECK_EQUAL(copy.getFunctionNextName(), "/F1a");
+  BOOST_CHECK_EQUAL(copy.getFunctionFullName(), "/F0b");
+  BOOST_CHECK(interest.wireEncode() == originalWire);
+
+  // a field set before it is accessed is not overwritten by the decoded value
+  interest.setFunctionNextName("/F2c");
+  BOOST_CHECK_EQUAL(interest.getFunctionNextName(), "/F2c");
+  BOOST_CHECK_EQUAL(interest.getFunctionFullName(), "/F0b");
+  BOOST_CHECK_EQUAL(Interest(interest.wireEncode()).getFunctionNextName(), "/F2c");
+
+  // decoding again replaces fields that were set
+  interest.wireDecode(originalWire);
+  BOOST_CHECK_EQUAL(interest.getFunctionNextName(), "/F1a");
+  BOOST_CHECK(interest == original);
+}
+
 BOOST_AUTO_TEST_CASE(MatchesData)
 {
   Interest interest;
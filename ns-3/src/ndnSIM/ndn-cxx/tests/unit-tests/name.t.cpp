@@ -483,6 +483,38 @@ BOOST_AUTO_TEST_CASE(SubNameOutOfRangeIndexes)
   BOOST_CHECK_EQUAL("/first/second/last", name.getSubName(-10, 10));
 }
 
+BOOST_AUTO_TEST_CASE(SubNameFromWire)
+{
+  EncodingBuffer buffer(1024, 0);
+  Name("/first/second/third/last").wireEncode(buffer);
+  Name name(buffer.block());
+
+  Name prefix = name.getPrefix(-1);
+  BOOST_CHECK_EQUAL(prefix, "/first/second/third");
+  BOOST_CHECK(prefix.hasWire());
+  BOOST_CHECK_LT(prefix.wireEncode().getBuffer()->size(), 1024);
+  BOOST_CHECK(prefix.wireEncode() == Name("/first/second/third").wireEncode());
+
+  BOOST_CHECK_EQUAL(name.getSubName(1, 2), "/second/third");
+  BOOST_CHECK(name.getSubName(1, 2).wireEncode() == Name("/second/third").wireEncode());
+  BOOST_CHECK(name.getSubName(10).wireEncode() == Name().wireEncode());
+}
+
+BOOST_AUTO_TEST_CASE(UriSharesBuffer)
+{
+  Name name("/hello/%41%42/world");
+
+  BOOST_CHECK(name.hasWire());
+  BOOST_REQUIRE_EQUAL(name.size(), 3);
+  BOOST_CHECK_EQUAL(name.get(1), name::Component("AB"));
+  BOOST_CHECK_EQUAL(name.get(0).getBuffer(), name.wireEncode().getBuffer());
+  BOOST_CHECK_EQUAL(name.get(2).getBuffer(), name.wireEncode().getBuffer());
+
+  Name appended;
+  appended.append("hello").append("AB").append("world");
+  BOOST_CHECK(name.wireEncode() == appended.wireEncode());
+}
+
 BOOST_AUTO_TEST_CASE(DeepCopy)
 {
   Name n1("/hello/world");
@@ -24,6 +24,7 @@
 #include "boost-test.hpp"
 #include "interest.hpp"
 #include "data.hpp"
+#include "lp/tags.hpp"
 
 #include <boost/mpl/vector.hpp>
 
@@ -52,6 +53,27 @@ public:
   }
 };
 
+/** \brief tag type with a large TypeId, whose getTypeId is not constexpr
+ */
+class LargeIdTag : public Tag
+{
+public:
+  static size_t
+  getTypeId()
+  {
+    return 0xaee87802;
+  }
+
+  explicit
+  LargeIdTag(int value)
+    : value(value)
+  {
+  }
+
+public:
+  int value;
+};
+
 typedef boost::mpl::vector<TagHost, Interest, Data> Fixtures;
 
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(Basic, T, Fixtures, T)
@@ -80,6 +102,52 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(Basic, T, Fixtures, T)
   BOOST_CHECK(this->template getTag<TestTag2>() == nullptr);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(InlineSlots, T, Fixtures, T)
+{
+  this->setTag(make_shared<lp::CongestionMarkTag>(1));
+  this->setTag(make_shared<lp::HopCountTag>(2));
+  this->setTag(make_shared<TestTag>());
+
+  BOOST_REQUIRE(this->template getTag<lp::CongestionMarkTag>() != nullptr);
+  BOOST_CHECK_EQUAL(*this->template getTag<lp::CongestionMarkTag>(), 1);
+  BOOST_REQUIRE(this->template getTag<lp::HopCountTag>() != nullptr);
+  BOOST_CHECK_EQUAL(*this->template getTag<lp::HopCountTag>(), 2);
+  BOOST_CHECK(this->template getTag<lp::IncomingFaceIdTag>() == nullptr);
+
+  // a copy shares the tags, but setting or removing a tag on it leaves the original unchanged
+  T copy(*this);
+  copy.setTag(make_shared<lp::HopCountTag>(3));
+  copy.template removeTag<lp::CongestionMarkTag>();
+  copy.template removeTag<TestTag>();
+
+  BOOST_CHECK_EQUAL(*copy.template getTag<lp::HopCountTag>(), 3);
+  BOOST_CHECK(copy.template getTag<lp::CongestionMarkTag>() == nullptr);
+  BOOST_CHECK(copy.template getTag<TestTag>() == nullptr);
+  BOOST_CHECK_EQUAL(*this->template getTag<lp::HopCountTag>(), 2);
+  BOOST_CHECK(this->template getTag<lp::CongestionMarkTag>() != nullptr);
+  BOOST_CHECK(this->template getTag<TestTag>() != nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(OtherTags, T, Fixtures, T)
+{
+  BOOST_CHECK(this->template getTag<LargeIdTag>() == nullptr);
+
+  this->setTag(make_shared<LargeIdTag>(1));
+  this->setTag(make_shared<TestTag>());
+  this->setTag(make_shared<lp::HopCountTag>(2));
+  BOOST_REQUIRE(this->template getTag<LargeIdTag>() != nullptr);
+  BOOST_CHECK_EQUAL(this->template getTag<LargeIdTag>()->value, 1);
+
+  this->setTag(make_shared<LargeIdTag>(3));
+  BOOST_CHECK_EQUAL(this->template getTag<LargeIdTag>()->value, 3);
+  BOOST_CHECK(this->template getTag<TestTag>() != nullptr);
+
+  this->template removeTag<LargeIdTag>();
+  BOOST_CHECK(this->template getTag<LargeIdTag>() == nullptr);
+  BOOST_CHECK(this->template getTag<TestTag>() != nullptr);
+  BOOST_CHECK_EQUAL(*this->template getTag<lp::HopCountTag>(), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -62,6 +62,37 @@ BOOST_AUTO_TEST_CASE(TestNfdContentStorePolicy)
   BOOST_CHECK_EQUAL(protoNode1->getForwarder()->getCs().getPolicy()->getName(), "priority_fifo");
 }
 
+BOOST_AUTO_TEST_CASE(TestNdnSimContentStorePolicy)
+{
+  NodeContainer nodes;
+  nodes.Create(2);
+
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.setCsSize(50);
+  ndnHelper.setPolicy("ndnSIM::cs::latency");
+  ndnHelper.Install(nodes.Get(0));
+
+  // ndnSIM content store with the selected policy replaces NFD's Content Store
+  Ptr<ContentStore> cs = nodes.Get(0)->GetObject<ContentStore>();
+  BOOST_REQUIRE(cs != nullptr);
+  BOOST_CHECK_EQUAL(cs->GetInstanceTypeId().GetName(), "ns3::ndn::cs::Latency");
+  UintegerValue maxSize;
+  cs->GetAttribute("MaxSize", maxSize);
+  BOOST_CHECK_EQUAL(maxSize.Get(), 50);
+  BOOST_CHECK(L3Protocol::getL3Protocol(nodes.Get(0))->getForwarder()->getContentStore() == cs);
+
+  // NFD's Content Store is reached through the same interface
+  ndnHelper.setPolicy("nfd::cs::lru");
+  ndnHelper.Install(nodes.Get(1));
+  cs = nodes.Get(1)->GetObject<ContentStore>();
+  BOOST_REQUIRE(cs != nullptr);
+  BOOST_CHECK_EQUAL(cs->GetInstanceTypeId().GetName(), "ns3::ndn::cs::Nfd");
+  BOOST_CHECK(L3Protocol::getL3Protocol(nodes.Get(1))->getForwarder()->getContentStore() == cs);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -87,6 +87,44 @@ BOOST_AUTO_TEST_CASE(EncodePrintData)
   }
 }
 
+BOOST_AUTO_TEST_CASE(DecodeRoundTrip)
+{
+  Data data("/other/prefix");
+  data.setContent(std::make_shared< ::ndn::Buffer>(1024));
+  ndn::StackHelper::getKeyChain().sign(data);
+  Block wire = lp::Packet(data.wireEncode()).wireEncode();
+
+  Ptr<Packet> packet = Create<Packet>();
+  packet->AddHeader(BlockHeader(nfd::face::Transport::Packet(Block(wire))));
+
+  BlockHeader peeked;
+  BOOST_CHECK_EQUAL(packet->PeekHeader(peeked), wire.size());
+  BOOST_CHECK(peeked.getBlock() == wire);
+  BOOST_CHECK_EQUAL(packet->GetSize(), wire.size());
+
+  BlockHeader removed;
+  BOOST_CHECK_EQUAL(packet->RemoveHeader(removed), wire.size());
+  BOOST_CHECK(removed.getBlock() == wire);
+  BOOST_CHECK_EQUAL(packet->GetSize(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(DecodeTruncated)
+{
+  Interest interest("/prefix");
+  interest.setNonce(10);
+  const Block& wire = interest.wireEncode();
+
+  // TLV-VALUE is shorter than TLV-LENGTH
+  Ptr<Packet> packet = Create<Packet>(wire.wire(), wire.size() - 3);
+  BlockHeader header;
+  BOOST_CHECK_THROW(packet->PeekHeader(header), ::ndn::tlv::Error);
+
+  // TLV-LENGTH is cut
+  static const uint8_t cutLength[] = {0x05, 0xFD, 0x01};
+  packet = Create<Packet>(cutLength, sizeof(cutLength));
+  BOOST_CHECK_THROW(packet->PeekHeader(header), ::ndn::tlv::Error);
+}
+
 BOOST_AUTO_TEST_CASE(PrintLpPacket)
 {
   Interest interest("/prefix");
@@ -155,6 +193,30 @@ BOOST_AUTO_TEST_CASE(PrintLpPacket)
   }
 }
 
+BOOST_AUTO_TEST_CASE(PrintLpBundle)
+{
+  Interest interest("/prefix");
+  interest.setNonce(10);
+  lp::Packet lpPacket1(interest.wireEncode());
+  lpPacket1.add<::ndn::lp::SequenceField>(0); // to make sure that the NDNLP header is added
+
+  lp::Packet lpPacket2(interest.wireEncode());
+  lpPacket2.add<::ndn::lp::NackField>(::ndn::lp::NackHeader().setReason(::ndn::lp::NackReason::NO_ROUTE));
+
+  Block bundle(::ndn::lp::tlv::LpBundle);
+  bundle.push_back(lpPacket1.wireEncode());
+  bundle.push_back(lpPacket2.wireEncode());
+  bundle.encode();
+
+  BlockHeader header(nfd::face::Transport::Packet(std::move(bundle)));
+  Ptr<Packet> packet = Create<Packet>();
+  packet->AddHeader(header);
+  boost::test_tools::output_test_stream output;
+  packet->Print(output);
+  BOOST_CHECK(output.is_equal("ns3::ndn::Packet (NDNLP bundle(NDNLP(Interest: /prefix?ndn.Nonce=10), "
+                              "NDNLP(NACK(NoRoute) for Interest: /prefix?ndn.Nonce=10)))"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
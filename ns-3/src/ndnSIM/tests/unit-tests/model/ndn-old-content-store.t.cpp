@@ -17,6 +17,7 @@
  * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
  **/
 
+#include "model/cs/ndn-content-store.hpp"
 
 #include "../tests-common.hpp"
 
@@ -67,6 +68,138 @@ BOOST_AUTO_TEST_CASE(RandomPolicy)
   BOOST_CHECK(entries["1"] != entries["2"]); // this test has a small chance of failing
 }
 
+static Ptr<ContentStore>
+makeContentStore(const std::string& typeId, const std::string& maxSize)
+{
+  ObjectFactory factory;
+  factory.SetTypeId(typeId);
+  factory.Set("MaxSize", StringValue(maxSize));
+  return factory.Create<ContentStore>();
+}
+
+static bool
+hasEntry(Ptr<ContentStore> cs, const Name& name)
+{
+  for (auto it = cs->Begin(); it != cs->End(); it = cs->Next(it)) {
+    if (it->GetName() == name) {
+      return true;
+    }
+  }
+  return false;
+}
+
+BOOST_AUTO_TEST_CASE(LatencyPolicy)
+{
+  Ptr<ContentStore> cs = makeContentStore("ns3::ndn::cs::Latency", "2");
+  cs->Add(make_shared<Data>("/A"), time::microseconds(30));
+  cs->Add(make_shared<Data>("/B"), time::microseconds(10));
+  cs->Add(make_shared<Data>("/C"), time::microseconds(20));
+
+  // entry with the lowest latency is evicted
+  BOOST_CHECK_EQUAL(cs->GetSize(), 2);
+  BOOST_CHECK(hasEntry(cs, "/A"));
+  BOOST_CHECK(!hasEntry(cs, "/B"));
+  BOOST_CHECK(hasEntry(cs, "/C"));
+
+  // among the same latency, the least recently used entry is evicted
+  cs = makeContentStore("ns3::ndn::cs::Latency", "2");
+  cs->Add(make_shared<Data>("/A"), time::microseconds(10));
+  cs->Add(make_shared<Data>("/B"), time::microseconds(10));
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/A")) != nullptr);
+  cs->Add(make_shared<Data>("/C"), time::microseconds(10));
+  BOOST_CHECK(hasEntry(cs, "/A"));
+  BOOST_CHECK(!hasEntry(cs, "/B"));
+  BOOST_CHECK(hasEntry(cs, "/C"));
+}
+
+BOOST_AUTO_TEST_CASE(LatencyRecencyPolicy)
+{
+  Ptr<ContentStore> cs = makeContentStore("ns3::ndn::cs::LatencyRecency", "2");
+  cs->Add(make_shared<Data>("/A"), time::milliseconds(100));
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+  cs->Add(make_shared<Data>("/B"), time::milliseconds(10));
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+  cs->Add(make_shared<Data>("/C"), time::milliseconds(10));
+
+  // priorities are 0.1s for /A and 1.01s for /B
+  BOOST_CHECK_EQUAL(cs->GetSize(), 2);
+  BOOST_CHECK(!hasEntry(cs, "/A"));
+  BOOST_CHECK(hasEntry(cs, "/B"));
+  BOOST_CHECK(hasEntry(cs, "/C"));
+}
+
+BOOST_AUTO_TEST_CASE(FunctionAwarePolicy)
+{
+  Ptr<ContentStore> cs = makeContentStore("ns3::ndn::cs::FunctionAware", "2");
+  auto dataA = make_shared<Data>("/A");
+  dataA->setTag(make_shared<lp::FunctionNameTag>(Name("/F1")));
+  cs->Add(dataA, time::nanoseconds::zero());
+  cs->Add(make_shared<Data>("/B"), time::nanoseconds::zero());
+  cs->Add(make_shared<Data>("/C"), time::nanoseconds::zero());
+
+  // least recently used entry without function is evicted
+  BOOST_CHECK_EQUAL(cs->GetSize(), 2);
+  BOOST_CHECK(hasEntry(cs, "/A"));
+  BOOST_CHECK(!hasEntry(cs, "/B"));
+  BOOST_CHECK(hasEntry(cs, "/C"));
+}
+
+BOOST_AUTO_TEST_CASE(LruEvictionManyEntries)
+{
+  Ptr<ContentStore> cs = makeContentStore("ns3::ndn::cs::Lru", "100");
+  for (int i = 0; i < 1000; ++i) {
+    cs->Add(make_shared<Data>(Name("/A").appendNumber(i % 10).appendNumber(i)),
+            time::nanoseconds::zero());
+  }
+
+  // evicted entries are removed from the trie and its exact-match index
+  BOOST_CHECK_EQUAL(cs->GetSize(), 100);
+  for (int i = 0; i < 1000; ++i) {
+    Name name = Name("/A").appendNumber(i % 10).appendNumber(i);
+    shared_ptr<const Data> found = cs->Lookup(make_shared<Interest>(name));
+    if (i < 900) {
+      BOOST_CHECK(found == nullptr);
+    }
+    else {
+      BOOST_REQUIRE(found != nullptr);
+      BOOST_CHECK_EQUAL(found->getName(), name);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(FreshnessCleaning)
+{
+  ObjectFactory factory;
+  factory.SetTypeId("ns3::ndn::cs::Freshness::Lru");
+  factory.Set("CleaningInterval", TimeValue(MilliSeconds(50)));
+  Ptr<ContentStore> cs = factory.Create<ContentStore>();
+
+  auto dataA = make_shared<Data>("/A");
+  dataA->setFreshnessPeriod(time::milliseconds(120));
+  cs->Add(dataA, time::nanoseconds::zero());
+  auto dataB = make_shared<Data>("/B");
+  dataB->setFreshnessPeriod(time::milliseconds(1000));
+  cs->Add(dataB, time::nanoseconds::zero());
+  cs->Add(make_shared<Data>("/C"), time::nanoseconds::zero());
+
+  // /A is removed at the end of the cleaning interval in which it expires
+  Simulator::Stop(MilliSeconds(140));
+  Simulator::Run();
+  BOOST_CHECK(hasEntry(cs, "/A"));
+  Simulator::Stop(MilliSeconds(20));
+  Simulator::Run();
+  BOOST_CHECK(!hasEntry(cs, "/A"));
+  BOOST_CHECK(hasEntry(cs, "/B"));
+
+  // Data without freshness period is not removed
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(cs->GetSize(), 1);
+  BOOST_CHECK(hasEntry(cs, "/C"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
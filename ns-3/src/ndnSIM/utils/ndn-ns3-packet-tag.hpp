@@ -29,7 +29,7 @@ namespace ndn {
 
 class Ns3PacketTag : public ::ndn::Tag {
 public:
-  static size_t
+  static constexpr size_t
   getTypeId()
   {
     return 0xaee87802; // md5("Ns3PacketTag")[0:8]
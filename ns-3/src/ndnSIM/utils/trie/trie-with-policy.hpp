@@ -24,6 +24,10 @@
 
 #include "trie.hpp"
 
+#include <algorithm>
+#include <functional>
+#include <vector>
+
 namespace ns3 {
 namespace ndn {
 namespace ndnSIM {
@@ -44,12 +48,19 @@ public:
   inline trie_with_policy(size_t bucketSize = 1, size_t bucketIncrement = 1)
     : trie_(name::Component(), bucketSize, bucketIncrement)
     , policy_(*this)
+    , exactCount_(0)
   {
   }
 
   inline std::pair<iterator, bool>
   insert(const FullKey& key, typename PayloadTraits::insert_type payload)
   {
+    std::size_t hash = std::hash<FullKey>()(key);
+    iterator existing = exact_find(key, hash);
+    if (existing != end()) {
+      return std::make_pair(existing, false);
+    }
+
     std::pair<iterator, bool> item = trie_.insert(key, payload);
 
     if (item.second) // real insert
@@ -59,6 +70,9 @@ public:
         item.first->erase(); // cannot insert
         return std::make_pair(end(), false);
       }
+
+      item.first->set_full_key_hash(hash);
+      exact_insert(item.first);
     }
     else {
       return std::make_pair(s_iterator_to(item.first), false);
@@ -70,14 +84,7 @@ public:
   inline void
   erase(const FullKey& key)
   {
-    iterator foundItem, lastItem;
-    bool reachLast;
-    std::tie(foundItem, reachLast, lastItem) = trie_.find(key);
-
-    if (!reachLast || lastItem->payload() == PayloadTraits::empty_payload)
-      return; // nothing to invalidate
-
-    erase(lastItem);
+    erase(find_exact(key));
   }
 
   inline void
@@ -87,6 +94,7 @@ public:
       return;
 
     policy_.erase(s_iterator_to(node));
+    exact_erase(node);
     node->erase(); // will do cleanup here
   }
 
@@ -95,6 +103,8 @@ public:
   {
     policy_.clear();
     trie_.clear();
+    std::fill(exact_.begin(), exact_.end(), iterator(0));
+    exactCount_ = 0;
   }
 
   template<typename Modifier>
@@ -117,14 +127,7 @@ public:
   inline iterator
   find_exact(const FullKey& key)
   {
-    iterator foundItem, lastItem;
-    bool reachLast;
-    std::tie(foundItem, reachLast, lastItem) = trie_.find(key);
-
-    if (!reachLast || lastItem->payload() == PayloadTraits::empty_payload)
-      return end();
-
-    return lastItem;
+    return exact_find(key, std::hash<FullKey>()(key));
   }
 
   /**
@@ -133,6 +136,13 @@ public:
   inline iterator
   longest_prefix_match(const FullKey& key)
   {
+    // an entry with exactly the key is the longest match
+    iterator exact = find_exact(key);
+    if (exact != end()) {
+      policy_.lookup(exact);
+      return exact;
+    }
+
     iterator foundItem, lastItem;
     bool reachLast;
     std::tie(foundItem, reachLast, lastItem) = trie_.find(key);
@@ -149,6 +159,12 @@ public:
   inline iterator
   longest_prefix_match_if(const FullKey& key, Predicate pred)
   {
+    iterator exact = find_exact(key);
+    if (exact != end() && pred(exact->payload())) {
+      policy_.lookup(exact);
+      return exact;
+    }
+
     iterator foundItem, lastItem;
     bool reachLast;
     std::tie(foundItem, reachLast, lastItem) = trie_.find_if(key, pred);
@@ -174,6 +190,13 @@ public:
   inline iterator
   deepest_prefix_match(const FullKey& key)
   {
+    // an entry with exactly the key is what the walk below would find
+    iterator exact = find_exact(key);
+    if (exact != end()) {
+      policy_.lookup(exact);
+      return exact;
+    }
+
     iterator foundItem, lastItem;
     bool reachLast;
     std::tie(foundItem, reachLast, lastItem) = trie_.find(key);
@@ -201,6 +224,12 @@ public:
   inline iterator
   deepest_prefix_match_if(const FullKey& key, Predicate pred)
   {
+    iterator exact = find_exact(key);
+    if (exact != end() && pred(exact->payload())) {
+      policy_.lookup(exact);
+      return exact;
+    }
+
     iterator foundItem, lastItem;
     bool reachLast;
     std::tie(foundItem, reachLast, lastItem) = trie_.find(key);
@@ -292,9 +321,90 @@ public:
       return &(*item);
   }
 
+private:
+  /**
+   * @brief Find the entry with exactly \p key in the exact-match index
+   *
+   * The index is an open-addressing table of the nodes that have a payload, keyed by the hash
+   * of the full key, so an exact lookup does not walk the trie component by component.
+   */
+  iterator
+  exact_find(const FullKey& key, std::size_t hash) const
+  {
+    if (exactCount_ == 0)
+      return end();
+
+    std::size_t mask = exact_.size() - 1;
+    for (std::size_t i = hash & mask; exact_[i] != 0; i = (i + 1) & mask) {
+      if (exact_[i]->full_key_hash() == hash && exact_[i]->is_key(key))
+        return exact_[i];
+    }
+    return end();
+  }
+
+  void
+  exact_insert(iterator node)
+  {
+    // keep the load factor at most 1/2
+    if ((exactCount_ + 1) * 2 > exact_.size()) {
+      std::vector<iterator> old(std::max<std::size_t>(exact_.size() * 2, 16), iterator(0));
+      old.swap(exact_);
+      BOOST_FOREACH (iterator item, old) {
+        if (item != 0)
+          exact_place(item);
+      }
+    }
+
+    exact_place(node);
+    ++exactCount_;
+  }
+
+  void
+  exact_place(iterator node)
+  {
+    std::size_t mask = exact_.size() - 1;
+    std::size_t i = node->full_key_hash() & mask;
+    while (exact_[i] != 0) {
+      i = (i + 1) & mask;
+    }
+    exact_[i] = node;
+  }
+
+  void
+  exact_erase(iterator node)
+  {
+    if (exactCount_ == 0)
+      return;
+
+    std::size_t mask = exact_.size() - 1;
+    std::size_t i = node->full_key_hash() & mask;
+    while (exact_[i] != node) {
+      if (exact_[i] == 0)
+        return; // not in the index
+      i = (i + 1) & mask;
+    }
+
+    // backward-shift deletion: move later entries of the probe sequence into the hole,
+    // so that every entry stays reachable from its home slot
+    for (std::size_t j = (i + 1) & mask; exact_[j] != 0; j = (j + 1) & mask) {
+      std::size_t home = exact_[j]->full_key_hash() & mask;
+      // the entry can fill the hole unless its home slot lies cyclically in (i, j]
+      bool canMove = (i <= j) ? (home <= i || home > j) : (home <= i && home > j);
+      if (canMove) {
+        exact_[i] = exact_[j];
+        i = j;
+      }
+    }
+    exact_[i] = 0;
+    --exactCount_;
+  }
+
 private:
   parent_trie trie_;
   mutable policy_container policy_;
+
+  std::vector<iterator> exact_; ///< exact-match index, see exact_find
+  std::size_t exactCount_;
 };
 
 } // ndnSIM
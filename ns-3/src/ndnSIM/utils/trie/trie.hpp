@@ -34,6 +34,9 @@
 #include <tuple>
 #include <boost/foreach.hpp>
 #include <boost/mpl/if.hpp>
+#include <boost/noncopyable.hpp>
+#include <type_traits>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -117,6 +120,76 @@ template<typename FullKey, typename PayloadTraits, typename PolicyHook>
 std::size_t
 hash_value(const trie<FullKey, PayloadTraits, PolicyHook>& trie_node);
 
+///////////////////////////////////////////////////
+// node allocation
+//
+
+/**
+ * @brief Pool of the nodes of one trie
+ *
+ * Nodes are carved from chunks of NODES_PER_CHUNK and recycled through a free list, so adding
+ * and pruning nodes does not go to the global allocator once the trie has grown.
+ * The chunks are released together with the trie.
+ */
+template<class Node>
+class trie_node_pool : boost::noncopyable {
+public:
+  static const size_t NODES_PER_CHUNK = 256;
+
+  trie_node_pool()
+    : free_(0)
+  {
+  }
+
+  ~trie_node_pool()
+  {
+    for (size_t i = 0; i < chunks_.size(); i++) {
+      ::operator delete(chunks_[i]);
+    }
+  }
+
+  void*
+  allocate()
+  {
+    if (free_ == 0) {
+      grow();
+    }
+
+    slot* item = free_;
+    free_ = item->next;
+    return item;
+  }
+
+  void
+  deallocate(void* node)
+  {
+    slot* item = static_cast<slot*>(node);
+    item->next = free_;
+    free_ = item;
+  }
+
+private:
+  union slot {
+    slot* next;
+    typename std::aligned_storage<sizeof(Node), alignof(Node)>::type storage;
+  };
+
+  void
+  grow()
+  {
+    slot* chunk = static_cast<slot*>(::operator new(sizeof(slot) * NODES_PER_CHUNK));
+    chunks_.push_back(chunk);
+    for (size_t i = NODES_PER_CHUNK; i > 0; i--) {
+      chunk[i - 1].next = free_;
+      free_ = &chunk[i - 1];
+    }
+  }
+
+private:
+  std::vector<slot*> chunks_;
+  slot* free_;
+};
+
 ///////////////////////////////////////////////////
 // actual definition
 //
@@ -142,17 +215,12 @@ public:
 
   typedef PayloadTraits payload_traits;
 
-  inline trie(const Key& key, size_t bucketSize = 1, size_t bucketIncrement = 1)
-    : key_(key)
-    , initialBucketSize_(bucketSize)
-    , bucketIncrement_(bucketIncrement)
-    , bucketSize_(initialBucketSize_)
-    , buckets_(new bucket_type[bucketSize_]) // cannot use normal pointer, because lifetime of
-                                             // buckets should be larger than lifetime of the
-                                             // container
-    , children_(bucket_traits(buckets_.get(), bucketSize_))
-    , payload_(PayloadTraits::empty_payload)
-    , parent_(nullptr)
+  /**
+   * @brief Construct the root of a trie, which owns the pool of all nodes of the trie
+   */
+  inline explicit
+  trie(const Key& key, size_t bucketSize = 1, size_t bucketIncrement = 1)
+    : trie(key, bucketSize, bucketIncrement, nullptr, new node_pool)
   {
   }
 
@@ -160,6 +228,10 @@ public:
   {
     payload_ = PayloadTraits::empty_payload; // necessary for smart pointers...
     children_.clear_and_dispose(trie_delete_disposer());
+
+    if (parent_ == nullptr) {
+      delete pool_;
+    }
   }
 
   void
@@ -196,11 +268,11 @@ public:
     trie* trieNode = this;
 
     BOOST_FOREACH (const Key& subkey, key) {
-      typename unordered_set::iterator item = trieNode->children_.find(subkey);
+      typename unordered_set::iterator item =
+        trieNode->children_.find(subkey, key_hash(), key_equal());
       if (item == trieNode->children_.end()) {
-        trie* newNode = new trie(subkey, initialBucketSize_, bucketIncrement_);
-        // std::cout << "new " << newNode << "\n";
-        newNode->parent_ = trieNode;
+        trie* newNode = new (pool_->allocate())
+          trie(subkey, initialBucketSize_, bucketIncrement_, trieNode, pool_);
 
         if (trieNode->children_.size() >= trieNode->bucketSize_) {
           trieNode->bucketSize_ += trieNode->bucketIncrement_;
@@ -208,7 +280,7 @@ public:
 
           buckets_array newBuckets(new bucket_type[trieNode->bucketSize_]);
           trieNode->children_.rehash(bucket_traits(newBuckets.get(), trieNode->bucketSize_));
-          trieNode->buckets_.swap(newBuckets);
+          trieNode->heapBuckets_.swap(newBuckets);
         }
 
         std::pair<typename unordered_set::iterator, bool> ret =
@@ -295,7 +367,8 @@ public:
     bool reachLast = true;
 
     BOOST_FOREACH (const Key& subkey, key) {
-      typename unordered_set::iterator item = trieNode->children_.find(subkey);
+      typename unordered_set::iterator item =
+        trieNode->children_.find(subkey, key_hash(), key_equal());
       if (item == trieNode->children_.end()) {
         reachLast = false;
         break;
@@ -326,7 +399,8 @@ public:
     bool reachLast = true;
 
     BOOST_FOREACH (const Key& subkey, key) {
-      typename unordered_set::iterator item = trieNode->children_.find(subkey);
+      typename unordered_set::iterator item =
+        trieNode->children_.find(subkey, key_hash(), key_equal());
       if (item == trieNode->children_.end()) {
         reachLast = false;
         break;
@@ -453,6 +527,36 @@ public:
     return key_;
   }
 
+  /**
+   * @brief Check whether the path from the root to this node spells \p key
+   */
+  bool
+  is_key(const FullKey& key) const
+  {
+    const trie* node = this;
+    for (size_t i = key.size(); i > 0; i--) {
+      if (node->parent_ == 0 || !(node->key_ == key[i - 1]))
+        return false;
+      node = node->parent_;
+    }
+    return node->parent_ == 0;
+  }
+
+  /**
+   * @brief Get hash of the full key, as recorded with set_full_key_hash
+   */
+  std::size_t
+  full_key_hash() const
+  {
+    return fullKeyHash_;
+  }
+
+  void
+  set_full_key_hash(std::size_t hash)
+  {
+    fullKeyHash_ = hash;
+  }
+
   inline void
   PrintStat(std::ostream& os) const;
 
@@ -462,7 +566,32 @@ private:
     void
     operator()(trie* delete_this)
     {
-      delete delete_this;
+      node_pool* pool = delete_this->pool_;
+      delete_this->~trie();
+      pool->deallocate(delete_this);
+    }
+  };
+
+  // look up a child by name component, without constructing a trie node for the component
+  struct key_hash {
+    std::size_t
+    operator()(const Key& key) const
+    {
+      return boost::hash_value(key);
+    }
+  };
+
+  struct key_equal {
+    bool
+    operator()(const Key& key, const trie& node) const
+    {
+      return key == node.key_;
+    }
+
+    bool
+    operator()(const trie& node, const Key& key) const
+    {
+      return key == node.key_;
     }
   };
 
@@ -481,17 +610,38 @@ public:
   PolicyHook policy_hook_;
 
 private:
-  boost::intrusive::unordered_set_member_hook<> unordered_set_member_hook_;
+  // the hash of the key is stored in the hook, so that rehashing does not hash keys again
+  // and a lookup compares hashes before components
+  typedef boost::intrusive::unordered_set_member_hook<boost::intrusive::store_hash<true>>
+    set_member_hook;
+  set_member_hook unordered_set_member_hook_;
 
   // necessary typedefs
   typedef trie self_type;
-  typedef boost::intrusive::member_hook<trie, boost::intrusive::unordered_set_member_hook<>,
-                                        &trie::unordered_set_member_hook_> member_hook;
+  typedef boost::intrusive::member_hook<trie, set_member_hook, &trie::unordered_set_member_hook_>
+    member_hook;
 
-  typedef boost::intrusive::unordered_set<trie, member_hook> unordered_set;
+  typedef boost::intrusive::unordered_set<trie, member_hook, boost::intrusive::compare_hash<true>>
+    unordered_set;
   typedef typename unordered_set::bucket_type bucket_type;
   typedef typename unordered_set::bucket_traits bucket_traits;
 
+  typedef trie_node_pool<trie> node_pool;
+
+  trie(const Key& key, size_t bucketSize, size_t bucketIncrement, trie* parent, node_pool* pool)
+    : key_(key)
+    , initialBucketSize_(bucketSize)
+    , bucketIncrement_(bucketIncrement)
+    , bucketSize_(initialBucketSize_)
+    , heapBuckets_(bucketSize_ != 1 ? new bucket_type[bucketSize_] : 0)
+    , children_(bucket_traits(bucketSize_ != 1 ? heapBuckets_.get() : &inlineBucket_, bucketSize_))
+    , payload_(PayloadTraits::empty_payload)
+    , parent_(parent)
+    , pool_(pool)
+    , fullKeyHash_(0)
+  {
+  }
+
   template<class T, class NonConstT>
   friend class trie_iterator;
 
@@ -509,11 +659,16 @@ private:
 
   size_t bucketSize_;
   typedef boost::interprocess::unique_ptr<bucket_type, array_disposer<bucket_type>> buckets_array;
-  buckets_array buckets_;
+  // buckets must outlive the container; a node with a single bucket (e.g., a leaf) uses
+  // inlineBucket_ and needs no separate allocation
+  bucket_type inlineBucket_;
+  buckets_array heapBuckets_;
   unordered_set children_;
 
   typename PayloadTraits::storage_type payload_;
   trie* parent_; // to make cleaning effective
+  node_pool* pool_; ///< pool of the trie, owned by the root
+  std::size_t fullKeyHash_;
 };
 
 template<typename FullKey, typename PayloadTraits, typename PolicyHook>